@@ -0,0 +1,67 @@
+#!/bin/bash
+# usage: ./bench.sh [--save] [<container>...] [-- <seed>]
+# run every workload of the given containers (all of them by default) with
+# ft and std, print the results and compare them with baseline.txt.
+# --save overwrite the baseline of the given containers with this run.
+
+cd "$(dirname "$0")"
+
+BASELINE=baseline.txt
+# a workload regress when its ft/std time ratio exceeds the baseline one by more than this factor
+TOLERANCE=${BENCH_TOLERANCE:-1.50}
+CONTAINERS="list xorlist vector deque map set multimap multiset btree_map btree_set stack queue priority_queue unordered_map unordered_set unordered_multimap unordered_multiset flat_hash_map flat_hash_set"
+
+SAVE=0
+SEED=42
+ARGS=""
+while [ $# -gt 0 ]; do
+	case "$1" in
+		--save) SAVE=1 ;;
+		--) shift; SEED=${1:-$SEED} ;;
+		*) ARGS="$ARGS $1" ;;
+	esac
+	shift
+done
+[ -n "$ARGS" ] && CONTAINERS=$ARGS
+
+RESULTS=$(mktemp)
+trap 'rm -f "$RESULTS"' EXIT
+
+printf "%-20s %-16s %12s %12s %8s %10s %10s %10s %10s\n" container workload "ft ns/op" "std ns/op" ratio "ft all/op" "std all/op" "ft KB" "std KB"
+for NAME in $CONTAINERS; do
+	make -s ft_$NAME std_$NAME > /dev/null || exit 1
+	for W in $(./ft_$NAME); do
+		read -r _ FT_NS FT_ALLOC FT_SUM FT_RSS <<< "$(./ft_$NAME $W $SEED)"
+		read -r _ STD_NS STD_ALLOC STD_SUM STD_RSS <<< "$(./std_$NAME $W $SEED)"
+		RATIO=$(awk -v a="$FT_NS" -v b="$STD_NS" 'BEGIN {printf "%.2f", (b > 0 ? a / b : 0)}')
+		printf "%-20s %-16s %12s %12s %8s %10s %10s %10s %10s" $NAME $W $FT_NS $STD_NS $RATIO $FT_ALLOC $STD_ALLOC $FT_RSS $STD_RSS
+		[ "$FT_SUM" != "$STD_SUM" ] && printf "  checksum differs"
+		printf "\n"
+		echo "$NAME $W $RATIO $FT_ALLOC $FT_SUM $STD_SUM" >> "$RESULTS"
+	done
+done
+
+if [ $SAVE -eq 1 ]; then
+	NEW=$(mktemp)
+	[ -f $BASELINE ] && grep -v -E "^($(echo $CONTAINERS | tr ' ' '|')) " $BASELINE > "$NEW"
+	awk '{print $1, $2, $3, $4}' "$RESULTS" >> "$NEW"
+	sort "$NEW" > $BASELINE
+	rm -f "$NEW"
+	echo "baseline saved in $BASELINE"
+	exit 0
+fi
+
+[ -f $BASELINE ] || { echo "no $BASELINE, run with --save to create it"; exit 0; }
+
+# a regression is a wrong result, a slower ft/std ratio or more allocations per operation than the baseline
+awk -v tolerance="$TOLERANCE" '
+	FNR == NR { ratio[$1 " " $2] = $3; alloc[$1 " " $2] = $4; next }
+	{
+		k = $1 " " $2
+		if ($5 != $6) { print "REGRESSION " k ": ft and std checksums differ"; ko = 1 }
+		if (!(k in ratio)) next
+		if ($3 > ratio[k] * tolerance && $3 > ratio[k] + 0.05) { print "REGRESSION " k ": ratio " $3 " (baseline " ratio[k] ")"; ko = 1 }
+		if ($4 > alloc[k] + 0.01) { print "REGRESSION " k ": " $4 " allocations/op (baseline " alloc[k] ")"; ko = 1 }
+	}
+	END { if (ko) exit 1; print "OK" }
+' $BASELINE "$RESULTS"
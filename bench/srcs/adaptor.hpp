@@ -0,0 +1,83 @@
+#ifndef BENCH_ADAPTOR_HPP
+#define BENCH_ADAPTOR_HPP
+# include "common.hpp"
+
+// workloads for stack, queue and priority_queue
+namespace adaptor
+{
+	// next element to be popped
+	template <class C>
+	typename C::value_type	top(const C &c) {return c.top();}
+
+#ifdef TEST_QUEUE
+	template <class T, class C>
+	T	top(const NAMESPACE::queue<T, C> &c) {return c.front();}
+#endif
+
+	template <class C>
+	void	push(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+			c.push(values[i]);
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	template <class C>
+	void	pop(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		for (size_t i = 0; i < values.size(); i++)
+			c.push(values[i]);
+		ctx.start();
+		while (!c.empty())
+			c.pop();
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// push and pop at a constant depth, like a message queue in steady state
+	template <class C>
+	void	steady(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		for (size_t i = 0; i < 1000; i++)
+			c.push(values[i]);
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			c.push(values[i]);
+			c.pop();
+		}
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	template <class C>
+	void	copy(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		for (size_t i = 0; i < values.size(); i++)
+			c.push(values[i]);
+		ctx.start();
+		C copy(c);
+		ctx.stop(c.size());
+		ctx.sink(copy.size());
+		ctx.sink(top(copy));
+	}
+
+	BUILD_TABLE(
+			WORKLOAD(push),
+			WORKLOAD(pop),
+			WORKLOAD(steady),
+			WORKLOAD(copy)
+	)
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef BENCH_ASSOCIATIVE_HPP
+#define BENCH_ASSOCIATIVE_HPP
+# include "common.hpp"
+# include <algorithm>
+
+namespace associative
+{
+	// key of an element, set elements are their own key
+	inline int	key(const int &value) {return value;}
+
+	template <typename L, typename R>
+	L	key(const NAMESPACE::pair<L, R> &value) {return value.first;}
+
+	// build an element from its key
+	template <class V>
+	struct value_of {
+		static V	make(int key) {return V(key);}
+	};
+
+	template <typename L, typename R>
+	struct value_of<NAMESPACE::pair<L, R> > {
+		static NAMESPACE::pair<L, R>	make(int key) {return NAMESPACE::pair<L, R>(key, R());}
+	};
+
+	// insert values in random order
+	template <class C>
+	void	insert(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+			c.insert(values[i]);
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// insert a range of sorted values (like reloading a snapshot)
+	template <class C>
+	void	insert_sorted(bench::context &ctx)
+	{
+		std::vector<typename C::key_type> keys = bench::get_random_vector<typename C::key_type>(BASE_SIZE);
+		std::sort(keys.begin(), keys.end());
+		std::vector<typename C::value_type> values;
+		for (size_t i = 0; i < keys.size(); i++)
+			values.push_back(value_of<typename C::value_type>::make(keys[i]));
+		ctx.start();
+		C c(values.begin(), values.end());
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// lookup of random keys, half of them are in the container
+	template <class C>
+	void	find(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		std::vector<typename C::key_type> keys = bench::get_random_vector<typename C::key_type>(BASE_SIZE);
+		for (size_t i = 0; i < keys.size(); i += 2)
+			keys[i] = key(values[std::rand() % values.size()]);
+		const C c(values.begin(), values.end());
+		ctx.start();
+		for (size_t i = 0; i < keys.size(); i++)
+			ctx.sink(c.find(keys[i]) != c.end());
+		ctx.stop(keys.size());
+	}
+
+	template <class C>
+	void	lower_bound(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		std::vector<typename C::key_type> keys = bench::get_random_vector<typename C::key_type>(BASE_SIZE);
+		const C c(values.begin(), values.end());
+		ctx.start();
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			typename C::const_iterator it = c.lower_bound(keys[i]);
+			ctx.sink(it == c.end() ? 0 : key(*it));
+		}
+		ctx.stop(keys.size());
+	}
+
+	template <class C>
+	void	count(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		std::vector<typename C::key_type> keys = bench::get_random_vector<typename C::key_type>(BASE_SIZE);
+		for (size_t i = 0; i < keys.size(); i += 2)
+			keys[i] = key(values[std::rand() % values.size()]);
+		const C c(values.begin(), values.end());
+		ctx.start();
+		for (size_t i = 0; i < keys.size(); i++)
+			ctx.sink(c.count(keys[i]));
+		ctx.stop(keys.size());
+	}
+
+	// erase all the elements by key in random order
+	template <class C>
+	void	erase(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c(values.begin(), values.end());
+		std::vector<typename C::key_type> keys;
+		for (size_t i = 0; i < values.size(); i++)
+			keys.push_back(key(values[(i * 7919) % values.size()]));
+		ctx.start();
+		for (size_t i = 0; i < keys.size(); i++)
+			ctx.sink(c.erase(keys[i]));
+		ctx.stop(keys.size());
+		ctx.sink(c.size());
+	}
+
+	template <class C>
+	void	iterate(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		const C c(values.begin(), values.end());
+		size_t sum = 0;
+		ctx.start();
+		for (int i = 0; i < 10; i++)
+			for (typename C::const_iterator it = c.begin(); it != c.end(); ++it)
+				sum += key(*it);
+		ctx.stop(10 * c.size());
+		ctx.sink(sum);
+	}
+
+	template <class C>
+	void	copy(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		const C c(values.begin(), values.end());
+		ctx.start();
+		C copy(c);
+		ctx.stop(c.size());
+		size_t sum = 0;
+		for (typename C::const_iterator it = copy.begin(); it != copy.end(); ++it)
+			sum += key(*it);
+		ctx.sink(sum);
+	}
+
+	BUILD_TABLE(
+			WORKLOAD(insert),
+			WORKLOAD(insert_sorted),
+			WORKLOAD(find),
+			WORKLOAD(lower_bound),
+			WORKLOAD(count),
+			WORKLOAD(erase),
+			WORKLOAD(iterate),
+			WORKLOAD(copy)
+	)
+}
+
+#endif
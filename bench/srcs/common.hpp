@@ -0,0 +1,234 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+# include <iostream>
+# include <iomanip>
+# include <string>
+# include <vector>
+# include <list>
+# include <cstdlib>
+# include <cstring>
+# include <new>
+# include <time.h>
+# include <sys/resource.h>
+# ifndef NAMESPACE
+#  define NAMESPACE std
+# endif
+// the variable BASE_SIZE define the number of operations done by a workload
+// (workloads that are quadratic on some containers use BASE_SIZE / 10)
+# ifndef BASE_SIZE
+#  define BASE_SIZE 200000
+# endif
+// each workload is run REPEAT times and only the fastest run is reported
+# ifndef REPEAT
+#  define REPEAT 5
+# endif
+// name a workload with the name of its function
+# define WORKLOAD(f) bench::workload<C>(#f, f<C>)
+// create a function get_table that return a table of workloads containing the workloads passed as arguments
+# define BUILD_TABLE(...)	\
+template <class C> \
+bench::workload_table<C> get_table () \
+{\
+	bench::workload<C> array[] = { __VA_ARGS__ };\
+	return bench::workload_table<C>(array, sizeof(array) / sizeof (*array));\
+}
+
+# if __cplusplus >= 201103L
+#  define BENCH_THROW_BAD_ALLOC
+#  define BENCH_NOTHROW noexcept
+# else
+#  define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+#  define BENCH_NOTHROW throw()
+# endif
+
+namespace bench {
+	// number of calls to the global operator new since the start of the program
+	size_t	allocations = 0;
+}
+
+// every allocator used by the containers ends up here, so counting the calls
+// gives the number of allocations done by a workload (they are kept out of
+// line so the compiler doesn't pair malloc/free with new/delete expressions)
+__attribute__((noinline)) void	*operator new(size_t size) BENCH_THROW_BAD_ALLOC
+{
+	bench::allocations++;
+	void *ret = std::malloc(size ? size : 1);
+	if (!ret)
+		throw std::bad_alloc();
+	return ret;
+}
+
+__attribute__((noinline)) void	operator delete(void *p) BENCH_NOTHROW
+{
+	std::free(p);
+}
+
+namespace bench {
+
+	// this class return a random value of the desired type (can be used like a function)
+	class get_value
+	{
+	public:
+		operator int()
+		{
+			return (std::rand());
+		}
+		operator std::string()
+		{
+			std::string ret = "";
+			for (int i = 0; i < 16; ++i)
+				ret += (std::rand() % 26) + 'a';
+			return (ret);
+		}
+#if defined(TEST_MAP) || defined(TEST_SET) || defined(TEST_MULTIMAP) || defined (TEST_MULTISET) || defined(TEST_BTREE_MAP) || defined(TEST_BTREE_SET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET) || defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET)
+		template <typename L, typename R>
+		operator NAMESPACE::pair<L, R>()
+		{
+			L key = *this;
+			return NAMESPACE::pair<L, R>(key, R());
+		}
+#endif
+	};
+
+	// return a vector of size n with random values of type T
+	template<typename T>
+	std::vector<T> get_random_vector(size_t n) {
+		std::vector<T> v;
+		v.reserve(n);
+		for (size_t i = 0; i < n; i++)
+			v.push_back(get_value());
+		return v;
+	}
+
+	// the state of one run of a workload
+	class context
+	{
+	private:
+		struct timespec	start_time;
+		size_t			start_allocations;
+	public:
+		double			ns;
+		size_t			ops;
+		size_t			allocations;
+		size_t			checksum;
+
+		context() : start_time(), start_allocations(0), ns(0), ops(0), allocations(0), checksum(0) {}
+
+		// begin the timed section
+		void	start()
+		{
+			this->start_allocations = bench::allocations;
+			clock_gettime(CLOCK_MONOTONIC, &this->start_time);
+		}
+
+		// end the timed section, ops is the number of operations done inside it
+		void	stop(size_t ops)
+		{
+			struct timespec end_time;
+			clock_gettime(CLOCK_MONOTONIC, &end_time);
+			this->allocations = bench::allocations - this->start_allocations;
+			this->ns = (end_time.tv_sec - this->start_time.tv_sec) * 1e9 + (end_time.tv_nsec - this->start_time.tv_nsec);
+			this->ops = ops ? ops : 1;
+		}
+
+		// feed a result to the checksum so the work can't be optimized away
+		// and ft and std can be checked to compute the same thing
+		void	sink(size_t value)
+		{
+			this->checksum = this->checksum * 31 + value;
+		}
+	};
+
+	// peak resident set size of the process in kilobytes
+	long	peak_rss()
+	{
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage))
+			return -1;
+		return usage.ru_maxrss;
+	}
+
+	template <class C>
+	struct workload
+	{
+		typedef void (*function_type)(context &);
+		const char		*name;
+		function_type	function;
+		workload(const char *n, function_type f) : name(n), function(f) {}
+	};
+
+	// class representing a table of workloads
+	template<typename C>
+	class workload_table
+	{
+	private:
+		std::list<workload<C> > internal;
+	public:
+		workload_table() {}
+		workload_table(workload<C> array[], size_t n) {
+			this->internal.assign(array, array + n);
+		}
+		const workload<C>	*find(const std::string &name) const
+		{
+			for (typename std::list<workload<C> >::const_iterator it = this->internal.begin(); it != this->internal.end(); it++)
+				if (name == it->name)
+					return &*it;
+			return NULL;
+		}
+		void	print() const
+		{
+			for (typename std::list<workload<C> >::const_iterator it = this->internal.begin(); it != this->internal.end(); it++)
+				std::cout << it->name << std::endl;
+		}
+		friend workload_table operator+(const workload_table<C> &l, const workload_table<C> &r)
+		{
+			workload_table ret = l;
+			ret.internal.insert(ret.internal.end(), r.internal.begin(), r.internal.end());
+			return ret;
+		}
+		friend workload_table operator+(const workload_table<C> &l, const workload<C> &r)
+		{
+			workload_table ret = l;
+			ret.internal.push_back(r);
+			return ret;
+		}
+	};
+
+	// the core function, without workload name it lists the workloads,
+	// otherwise it runs the workload REPEAT times and prints on one line:
+	// <workload> <ns/op> <allocations/op> <checksum> <peak rss in KB>
+	template <class C>
+	int	run(const workload_table<C> &table, int ac, char **av)
+	{
+		if (ac < 2)
+		{
+			table.print();
+			return 0;
+		}
+		const workload<C> *w = table.find(av[1]);
+		if (!w)
+		{
+			std::cerr << "unknown workload: " << av[1] << std::endl;
+			return 1;
+		}
+		unsigned int seed = ac > 2 ? std::atol(av[2]) : 0;
+		context best;
+		for (int i = 0; i < REPEAT; i++)
+		{
+			context ctx;
+			std::srand(seed);
+			w->function(ctx);
+			if (i == 0 || ctx.ns < best.ns)
+				best = ctx;
+		}
+		std::cout << std::fixed << std::setprecision(2)
+			<< w->name << " "
+			<< best.ns / best.ops << " "
+			<< std::setprecision(4) << (double)best.allocations / best.ops << " "
+			<< best.checksum << " "
+			<< bench::peak_rss() << std::endl;
+		return 0;
+	}
+}
+
+#endif
@@ -0,0 +1,221 @@
+#ifdef TEST_FT
+# define NAMESPACE ft
+# if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTIMAP)
+#  include "unordered_map.hpp"
+# endif
+# if defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTISET)
+#  include "unordered_set.hpp"
+# endif
+# ifdef TEST_FLAT_HASH_MAP
+#  include "flat_hash_map.hpp"
+# endif
+# ifdef TEST_FLAT_HASH_SET
+#  include "flat_hash_set.hpp"
+# endif
+# if defined(TEST_MAP) || defined(TEST_MULTIMAP)
+#  include "map.hpp"
+# endif
+# if defined(TEST_SET) || defined(TEST_MULTISET)
+#  include "set.hpp"
+# endif
+# ifdef TEST_BTREE_MAP
+#  include "btree_map.hpp"
+# endif
+# ifdef TEST_BTREE_SET
+#  include "btree_set.hpp"
+# endif
+# ifdef TEST_VECTOR
+#  include "vector.hpp"
+# endif
+# ifdef TEST_STACK
+#  include "stack.hpp"
+# endif
+# ifdef TEST_QUEUE
+#  include "queue.hpp"
+# endif
+# ifdef TEST_DEQUE
+#  include "deque.hpp"
+# endif
+# ifdef TEST_LIST
+#  include "list.hpp"
+# endif
+# ifdef TEST_XORLIST
+#  include "xorlist.hpp"
+# endif
+# ifdef TEST_PRIORITY_QUEUE
+#  include "queue.hpp"
+# endif
+#elif defined(TEST_STD)
+# define NAMESPACE std
+# if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTIMAP)
+#  include <unordered_map>
+# endif
+# if defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTISET)
+#  include <unordered_set>
+# endif
+# ifdef TEST_FLAT_HASH_MAP
+#  include <unordered_map>
+#define flat_hash_map unordered_map
+# endif
+# ifdef TEST_FLAT_HASH_SET
+#  include <unordered_set>
+#define flat_hash_set unordered_set
+# endif
+# if defined(TEST_MAP) || defined(TEST_MULTIMAP)
+#  include <map>
+# endif
+# if defined(TEST_SET) || defined(TEST_MULTISET)
+#  include <set>
+# endif
+# ifdef TEST_BTREE_MAP
+#  include <map>
+#define btree_map map
+# endif
+# ifdef TEST_BTREE_SET
+#  include <set>
+#define btree_set set
+# endif
+# ifdef TEST_VECTOR
+#  include <vector>
+# endif
+# ifdef TEST_STACK
+#  include <stack>
+# endif
+# ifdef TEST_QUEUE
+#  include <queue>
+# endif
+# ifdef TEST_DEQUE
+#  include <deque>
+# endif
+# ifdef TEST_LIST
+#  include <list>
+# endif
+# ifdef TEST_XORLIST
+#  include <list>
+#define xorlist list
+# endif
+# ifdef TEST_PRIORITY_QUEUE
+#  include <queue>
+# endif
+#endif
+
+#if defined(TEST_MAP) || defined(TEST_SET) || defined(TEST_MULTIMAP) || defined (TEST_MULTISET) || defined(TEST_BTREE_MAP) || defined(TEST_BTREE_SET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET) || defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET)
+# ifdef TEST_FT
+#  include "utility.hpp"
+# else
+#  include <utility>
+# endif
+#endif
+
+#include "common.hpp"
+#if defined (TEST_SET) || defined(TEST_MAP) || defined(TEST_MULTISET) || defined(TEST_MULTIMAP) || defined(TEST_BTREE_MAP) || defined(TEST_BTREE_SET)
+# include "associative.hpp"
+#endif
+#if defined (TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTISET) || defined(TEST_UNORDERED_MULTIMAP) \
+	|| defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET)
+# include "unordered_associative.hpp"
+#endif
+#if defined (TEST_VECTOR) || defined(TEST_DEQUE) || defined(TEST_LIST) || defined(TEST_XORLIST)
+# include "sequence.hpp"
+#endif
+#if defined(TEST_STACK) || defined(TEST_QUEUE) || defined(TEST_PRIORITY_QUEUE)
+# include "adaptor.hpp"
+#endif
+
+int main(int argc, char **argv)
+{
+	#ifdef TEST_UNORDERED_MAP
+	typedef NAMESPACE::unordered_map<int, int> C;
+	return bench::run<C>(unordered_associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_UNORDERED_MULTIMAP
+	typedef NAMESPACE::unordered_multimap<int, int> C;
+	return bench::run<C>(unordered_associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_UNORDERED_SET
+	typedef NAMESPACE::unordered_set<int> C;
+	return bench::run<C>(unordered_associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_UNORDERED_MULTISET
+	typedef NAMESPACE::unordered_multiset<int> C;
+	return bench::run<C>(unordered_associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_FLAT_HASH_MAP
+	typedef NAMESPACE::flat_hash_map<int, int> C;
+	return bench::run<C>(unordered_associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_FLAT_HASH_SET
+	typedef NAMESPACE::flat_hash_set<int> C;
+	return bench::run<C>(unordered_associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_MAP
+	typedef NAMESPACE::map<int, int> C;
+	return bench::run<C>(associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_SET
+	typedef NAMESPACE::set<int> C;
+	return bench::run<C>(associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_MULTIMAP
+	typedef NAMESPACE::multimap<int, int> C;
+	return bench::run<C>(associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_MULTISET
+	typedef NAMESPACE::multiset<int> C;
+	return bench::run<C>(associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_BTREE_MAP
+	typedef NAMESPACE::btree_map<int, int> C;
+	return bench::run<C>(associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_BTREE_SET
+	typedef NAMESPACE::btree_set<int> C;
+	return bench::run<C>(associative::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_VECTOR
+	typedef NAMESPACE::vector<int> C;
+	return bench::run<C>(sequence::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_DEQUE
+	typedef NAMESPACE::deque<int> C;
+	return bench::run<C>(sequence::get_table<C>() + bench::workload<C>("push_front", sequence::push_front<C>), argc, argv);
+	#endif
+
+	#ifdef TEST_LIST
+	typedef NAMESPACE::list<int> C;
+	return bench::run<C>(sequence::get_table<C>() + bench::workload<C>("push_front", sequence::push_front<C>), argc, argv);
+	#endif
+
+	#ifdef TEST_XORLIST
+	typedef NAMESPACE::xorlist<int> C;
+	return bench::run<C>(sequence::get_table<C>() + bench::workload<C>("push_front", sequence::push_front<C>), argc, argv);
+	#endif
+
+	#ifdef TEST_PRIORITY_QUEUE
+	typedef NAMESPACE::priority_queue<int> C;
+	return bench::run<C>(adaptor::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_STACK
+	typedef NAMESPACE::stack<int> C;
+	return bench::run<C>(adaptor::get_table<C>(), argc, argv);
+	#endif
+
+	#ifdef TEST_QUEUE
+	typedef NAMESPACE::queue<int> C;
+	return bench::run<C>(adaptor::get_table<C>(), argc, argv);
+	#endif
+}
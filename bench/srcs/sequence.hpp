@@ -0,0 +1,139 @@
+#ifndef BENCH_SEQUENCE_HPP
+#define BENCH_SEQUENCE_HPP
+# include "common.hpp"
+
+namespace sequence
+{
+	template <class C>
+	void	push_back(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+			c.push_back(values[i]);
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	template <class C>
+	void	push_front(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+			c.push_front(values[i]);
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// insert one by one in the middle of the container
+	template <class C>
+	void	insert(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE / 10);
+		C c(values.begin(), values.end());
+		typename C::iterator pos = c.begin();
+		for (size_t i = 0; i < c.size() / 2; i++)
+			++pos;
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+			pos = c.insert(pos, values[i]);
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// insert a whole range in the middle of the container
+	template <class C>
+	void	insert_range(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c(values.begin(), values.end());
+		typename C::iterator pos = c.begin();
+		for (size_t i = 0; i < c.size() / 2; i++)
+			++pos;
+		ctx.start();
+		c.insert(pos, values.begin(), values.end());
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// erase one by one in the middle of the container
+	template <class C>
+	void	erase(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE / 10);
+		C c(values.begin(), values.end());
+		typename C::iterator pos = c.begin();
+		for (size_t i = 0; i < c.size() / 2; i++)
+			++pos;
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			if (pos == c.end())
+				pos = c.begin();
+			pos = c.erase(pos);
+		}
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	// linear search of values, half of them are in the container
+	template <class C>
+	void	find(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		std::vector<typename C::value_type> keys = bench::get_random_vector<typename C::value_type>(BASE_SIZE / 2000);
+		for (size_t i = 0; i < keys.size(); i += 2)
+			keys[i] = values[std::rand() % values.size()];
+		C c(values.begin(), values.end());
+		ctx.start();
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			typename C::const_iterator it = c.begin();
+			while (it != c.end() && !(*it == keys[i]))
+				++it;
+			ctx.sink(it != c.end());
+		}
+		ctx.stop(keys.size());
+	}
+
+	template <class C>
+	void	iterate(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		const C c(values.begin(), values.end());
+		size_t sum = 0;
+		ctx.start();
+		for (int i = 0; i < 10; i++)
+			for (typename C::const_iterator it = c.begin(); it != c.end(); ++it)
+				sum += *it;
+		ctx.stop(10 * c.size());
+		ctx.sink(sum);
+	}
+
+	template <class C>
+	void	copy(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		const C c(values.begin(), values.end());
+		ctx.start();
+		C copy(c);
+		ctx.stop(c.size());
+		for (typename C::const_iterator it = copy.begin(); it != copy.end(); ++it)
+			ctx.sink(*it);
+	}
+
+	BUILD_TABLE(
+			WORKLOAD(push_back),
+			WORKLOAD(insert),
+			WORKLOAD(insert_range),
+			WORKLOAD(erase),
+			WORKLOAD(find),
+			WORKLOAD(iterate),
+			WORKLOAD(copy)
+	)
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef BENCH_UNORDERED_ASSOCIATIVE_HPP
+#define BENCH_UNORDERED_ASSOCIATIVE_HPP
+# include "common.hpp"
+# include "associative.hpp"
+
+namespace unordered_associative
+{
+	// insert values in random order into a table which was reserved beforehand
+	template <class C>
+	void	insert_reserved(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c;
+		c.reserve(values.size());
+		ctx.start();
+		for (size_t i = 0; i < values.size(); i++)
+			c.insert(values[i]);
+		ctx.stop(values.size());
+		ctx.sink(c.size());
+	}
+
+	template <class C>
+	void	rehash(bench::context &ctx)
+	{
+		std::vector<typename C::value_type> values = bench::get_random_vector<typename C::value_type>(BASE_SIZE);
+		C c(values.begin(), values.end());
+		ctx.start();
+		c.rehash(c.bucket_count() * 4);
+		ctx.stop(c.size());
+		ctx.sink(c.size());
+	}
+
+	BUILD_TABLE(
+			bench::workload<C>("insert", associative::insert<C>),
+			WORKLOAD(insert_reserved),
+			bench::workload<C>("find", associative::find<C>),
+			bench::workload<C>("count", associative::count<C>),
+			bench::workload<C>("erase", associative::erase<C>),
+			bench::workload<C>("iterate", associative::iterate<C>),
+			WORKLOAD(rehash),
+			bench::workload<C>("copy", associative::copy<C>)
+	)
+}
+
+#endif
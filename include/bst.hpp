@@ -8,13 +8,31 @@
 #include "functional.hpp"
 #include <iostream>
 
+// number of nodes in the subtree of a node, only kept by trees with order statistics
+template<bool OrderStatistics>
+struct bst_node_weight {
+	bst_node_weight() : weight(1) {}
+	size_t	weight;
+};
+
+template<>
+struct bst_node_weight<false> {};
+
+// only defined for unique trees, naming it in a multi tree does not compile
+template<bool multi>
+struct bst_unique_keys_only;
+
+template<>
+struct bst_unique_keys_only<false> {};
+
 template<
 		class	Key,
 		class	Value,
 		class	Compare = ft::less <Key>,
 		class	Allocator = std::allocator <Key>,
         bool	multi = false,
-		class	KeyOfValue = ft::identity
+		class	KeyOfValue = ft::identity,
+		bool	OrderStatistics = false
 >
 class bst {
 public:
@@ -44,9 +62,17 @@ public:
 private:
 	enum e_color {BLACK, RED};
 	enum e_dir {LEFT, RIGHT};
-	struct node_type_base {
+	enum e_chunk {MIN_CHUNK = 8, MAX_CHUNK = 1024};
+	// a red-black tree is at most twice as high as a perfectly balanced one
+	enum e_height {MAX_HEIGHT = 2 * sizeof(size_t) * 8};
+	typedef ft::integral_constant<bool, OrderStatistics> order_statistics;
+	// the lookups taking any key type K exist only for comparators declaring is_transparent
+	template<class K, class R>
+	struct if_transparent : public ft::enable_if<ft::is_transparent<Compare>::value, R> {};
+	struct node_type_base : public bst_node_weight<OrderStatistics> {
 		node_type_base() : l(NULL), r(NULL), p(NULL), color(BLACK) {}
-		node_type_base(const node_type_base &other) : l(other.l), r(other.r), p(other.p), color(other.color) {}
+		node_type_base(const node_type_base &other) : bst_node_weight<OrderStatistics>(other), l(other.l), r(other.r),
+		p(other.p), color(other.color) {}
 		union {
 			struct {
 				node_type_base *l;
@@ -89,6 +115,15 @@ private:
 		node_type(const node_type &other) : node_type_base(other), value(other.value) {}
 		value_type value;
 	};
+	// nodes are carved out of chunks, the first slot of a chunk holds this header
+	struct node_chunk {
+		node_chunk	*next;
+		size_type	count;
+	};
+	// erased nodes are kept in a list linked through their storage
+	struct free_node {
+		free_node	*next;
+	};
 	template<typename pointed_type>
 	struct iterator_t {
 		typedef ptrdiff_t difference_type;
@@ -154,20 +189,26 @@ private:
 	node_type_base super_root;
 	node_type_base *first;
 	node_type_base *last;
+	node_chunk *chunks;
+	free_node *free_nodes;
+	node_type *bump;
+	node_type *bump_end;
 public:
-	bst() : compare(), _value_comp(compare), _size(), allocator(), super_root(), first(&this->super_root), last(&this->super_root) {};
+	bst() : compare(), _value_comp(compare), _size(), allocator(), super_root(), first(&this->super_root), last(&this->super_root),
+	chunks(NULL), free_nodes(NULL), bump(NULL), bump_end(NULL) {};
 
 	explicit bst(const Compare &comp, const Allocator &alloc = Allocator()) : compare(comp), _value_comp(comp), _size(),
-	allocator(alloc), super_root(), first(&this->super_root), last(&this->super_root) {}
+	allocator(alloc), super_root(), first(&this->super_root), last(&this->super_root), chunks(NULL), free_nodes(NULL), bump(NULL), bump_end(NULL) {}
 
 	template<class InputIt>
 	bst(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) : compare(
-			comp), _value_comp(comp), _size(), allocator(alloc), super_root(), first(&this->super_root), last(&this->super_root) {
+			comp), _value_comp(comp), _size(), allocator(alloc), super_root(), first(&this->super_root), last(&this->super_root),
+			chunks(NULL), free_nodes(NULL), bump(NULL), bump_end(NULL) {
 		this->insert(first, last);
 	}
 
 	bst(const bst &other) : compare(other.compare), _value_comp(other._value_comp), _size(0), allocator(other.allocator),
-	super_root(), first(&this->super_root), last(&this->super_root) {
+	super_root(), first(&this->super_root), last(&this->super_root), chunks(NULL), free_nodes(NULL), bump(NULL), bump_end(NULL) {
 		*this = other;
 	}
 
@@ -180,7 +221,7 @@ public:
 		this->compare = other.compare;
 		this->_value_comp = other._value_comp;
 		this->allocator = other.allocator;
-		this->assign_tree(copy_tree(other, other.super_root.l));
+		this->assign_root(this->copy_tree(other.super_root.l));
 		return *this;
 	}
 
@@ -208,11 +249,12 @@ public:
 
 	size_type max_size() const { return this->allocator.max_size(); };
 
+	// the values are destroyed (if they have to) and the chunks are released without freeing nodes one by one
 	void clear() {
-		destroy_tree(this->super_root.l);
+		destroy_tree(this->super_root.l, typename ft::is_trivially_destructible<value_type>::type());
 		this->assign_tree(NULL);
-		this->first = &this->super_root;
-		this->last = &this->super_root;
+		this->release_chunks();
+		this->_size = 0;
 	}
 
 	typename ft::conditional<multi, iterator, ft::pair<iterator, bool> >::type insert(const value_type &value) {
@@ -220,7 +262,7 @@ public:
 	}
 private:
 	ft::pair<iterator, bool> insert(const value_type &value, ft::true_type) {
-		ft::pair<iterator, bool> ret = this->recursive_insert(this->super_root.l, &this->super_root, value);
+		ft::pair<iterator, bool> ret = this->insert_from(&this->super_root.l, &this->super_root, value);
 		if (ret.second && ret.first.current == this->super_root.l)
 			this->super_root.r = this->super_root.l;
 		return ret;
@@ -230,38 +272,44 @@ private:
 		return this->insert(value, ft::true_type()).first;
 	}
 public:
+	// the value goes right before pos if it belongs there, otherwise right after it or, failing both, it is searched
+	// from pos: like the stl, multi trees put an equal value as close as possible before pos, and after its equals
+	// when searched (before them if it is past pos)
 	iterator insert(iterator pos, const value_type &value) {
-		node_type_base *current = pos.current;
-		node_type_base *next = next_node(current);
-		if (multi)
+		if (this->empty())
+			return this->insert(value, ft::true_type()).first;
+		node_type_base *n = pos.current;
+		if (n == &this->super_root)
 		{
-			// if current <= value < next
-			if (current != &this->super_root && !this->_value_comp(value, static_cast<node_type *>(current)->value) &&
-				(next == &this->super_root || !this->_value_comp(static_cast<node_type *>(next)->value, value))) {
-				if (!current->r)
-					return this->recursive_insert(current->r, current, value).first;
-				return this->recursive_insert(next->l, next, value).first;
-			}
-			return this->insert(value, ft::false_type ());
+			if (this->goes_after(this->last, value))
+				return this->insert_before(n, value);
+			return this->insert_search(this->last, value, false);
 		}
-		else
+		if (this->goes_before(value, n))
 		{
-			// if current < value < next
-			if (current != &this->super_root && this->_value_comp(static_cast<node_type *>(current)->value,value) &&
-				(next == &this->super_root || this->_value_comp(value, static_cast<node_type *>(next)->value))) {
-				if (!current->r)
-					return this->recursive_insert(current->r, current, value).first;
-				return this->recursive_insert(next->l, next, value).first;
-			}
+			if (n == this->first || this->goes_after(prev_node(n), value))
+				return this->insert_before(n, value);
+			return this->insert_search(n, value, false);
 		}
-		return this->insert(value, ft::true_type()).first;
+		if (this->goes_after(n, value))
+		{
+			node_type_base *next = next_node(n);
+			if (next == &this->super_root || this->goes_before(value, next))
+				return this->insert_before(next, value);
+			return this->insert_search(next, value, true);
+		}
+		return iterator(n);
 	}
 
+	// each value is searched from the previous one, sorted ranges are inserted in constant time per element and
+	// equal values of multi trees go after the equal elements already there, like the stl
 	template<class InputIt>
 	void insert(InputIt f, InputIt l) {
-		iterator tmp = this->begin();
+		if (this->empty())
+			this->build_sorted_prefix(f, l);
+		node_type_base *n = this->last;
 		while (f != l) {
-			tmp = this->insert(tmp, (value_type)*f);
+			n = this->insert_after(n, (value_type)*f).current;
 			f++;
 		}
 	}
@@ -281,13 +329,17 @@ public:
 
 	size_type erase(const Key &key) {
 		if (!multi)
-			return this->erase_multi(this->super_root.l, key);
+		{
+			node_type_base *n = this->find_node(key);
+			if (!n)
+				return 0;
+			this->erase_node(*n);
+			return 1;
+		}
 		ft::pair<iterator, iterator> range = this->equal_range(key);
 		size_type ret = ft::distance(range.first, range.second);
 		this->erase(range.first, range.second);
 		return ret;
-
-		return this->erase_multi(this->super_root.l, key);
 	}
 
 	void swap(bst &other) {
@@ -301,12 +353,53 @@ public:
 		other.assign_tree(tree);
 		ft::swap(this->allocator, other.allocator);
 		ft::swap(this->_size, other._size);
+		ft::swap(this->chunks, other.chunks);
+		ft::swap(this->free_nodes, other.free_nodes);
+		ft::swap(this->bump, other.bump);
+		ft::swap(this->bump_end, other.bump_end);
+	}
+
+	size_type count(const Key &key) const {
+		if (!multi)
+			return this->find_node(key) != NULL;
+		return this->count_multi(key, order_statistics());
 	}
 
-	size_type count(const Key &key) const {return this->recursive_count(this->super_root.l, key);}
+	template<class K>
+	typename if_transparent<K, size_type>::type count(const K &key) const {
+		if (!multi)
+			return this->find_node(key) != NULL;
+		return this->count_multi(key, order_statistics());
+	}
+private:
+	template<class K>
+	size_type count_multi(const K &key, ft::true_type) const {
+		size_type ret = 0;
+		node_type_base *n = this->super_root.l;
+		while (n)
+		{
+			if (!this->compare(key, KeyOfValue()(static_cast<node_type*>(n)->value)))
+			{
+				ret += weight(n->l) + 1;
+				n = n->r;
+			}
+			else
+				n = n->l;
+		}
+		return ret - this->internal_rank(key);
+	}
+
+	template<class K>
+	size_type count_multi(const K &key, ft::false_type) const {
+		size_type ret = 0;
+		for (const_iterator it = this->internal_lower_bound(key); it != this->end() && !this->compare(key, KeyOfValue()(*it)); ++it)
+			ret++;
+		return ret;
+	}
+public:
 
 	iterator find(const Key &key) {
-		node_type_base *tmp = this->recursive_find(this->super_root.l, key);
+		node_type_base *tmp = this->find_node(key);
 		if (!tmp)
 			return this->end();
 		return iterator(tmp);
@@ -314,7 +407,7 @@ public:
 
 	const_iterator find(const Key &key) const
 	{
-		node_type_base *tmp = this->recursive_find(this->super_root.l, key);
+		node_type_base *tmp = this->find_node(key);
 		if (!tmp)
 			return this->end();
 		return const_iterator(tmp);
@@ -346,6 +439,153 @@ public:
 		return internal_lower_bound(key);
 	}
 
+	template<class K>
+	typename if_transparent<K, iterator>::type find(const K &key) {
+		node_type_base *tmp = this->find_node(key);
+		if (!tmp)
+			return this->end();
+		return iterator(tmp);
+	}
+
+	template<class K>
+	typename if_transparent<K, const_iterator>::type find(const K &key) const {
+		node_type_base *tmp = this->find_node(key);
+		if (!tmp)
+			return this->end();
+		return const_iterator(tmp);
+	}
+
+	template<class K>
+	typename if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K &key) {
+		return ft::make_pair<iterator,iterator>(this->internal_lower_bound(key), this->internal_upper_bound(key));
+	}
+
+	template<class K>
+	typename if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K &key) const {
+		return ft::make_pair<const_iterator,const_iterator>(this->internal_lower_bound(key), this->internal_upper_bound(key));
+	}
+
+	template<class K>
+	typename if_transparent<K, iterator>::type upper_bound(const K &key) {
+		return internal_upper_bound(key);
+	}
+
+	template<class K>
+	typename if_transparent<K, const_iterator>::type upper_bound(const K &key) const {
+		return internal_upper_bound(key);
+	}
+
+	template<class K>
+	typename if_transparent<K, iterator>::type lower_bound(const K &key) {
+		return internal_lower_bound(key);
+	}
+
+	template<class K>
+	typename if_transparent<K, const_iterator>::type lower_bound(const K &key) const {
+		return internal_lower_bound(key);
+	}
+
+	// lower_bound searched from hint, in O(log d) where d is the distance from hint to the result
+	iterator lower_bound( const_iterator hint, const Key& key ) {
+		return this->hinted_lower_bound(hint.current, key);
+	}
+
+	const_iterator lower_bound( const_iterator hint, const Key& key ) const {
+		return this->hinted_lower_bound(hint.current, key);
+	}
+
+	// call fn on every element in order, with a stack instead of the parent links the iterators climb
+	template<class Function>
+	Function for_each(Function fn) {
+		return this->template visit<value_type&>(NULL, NULL, fn);
+	}
+
+	template<class Function>
+	Function for_each(Function fn) const {
+		return this->template visit<const value_type&>(NULL, NULL, fn);
+	}
+
+	// same for the elements whose key is in [lo, hi)
+	template<class Function>
+	Function visit_range(const Key &lo, const Key &hi, Function fn) {
+		return this->template visit<value_type&>(&lo, &hi, fn);
+	}
+
+	template<class Function>
+	Function visit_range(const Key &lo, const Key &hi, Function fn) const {
+		return this->template visit<const value_type&>(&lo, &hi, fn);
+	}
+
+	// the following need OrderStatistics
+
+	// element at index k, end() if there is none
+	iterator nth(size_type k) {
+		return internal_nth(k);
+	}
+
+	const_iterator nth(size_type k) const {
+		return internal_nth(k);
+	}
+
+	// number of elements whose key is less than key
+	size_type rank(const Key &key) const {
+		return this->internal_rank(key);
+	}
+
+	// number of elements whose key is in [lo, hi)
+	size_type count_range(const Key &lo, const Key &hi) const {
+		if (!this->compare(lo, hi))
+			return 0;
+		return this->rank(hi) - this->rank(lo);
+	}
+
+	// the set operations are for unique trees and do not compile on multi ones, they take time proportional
+	// to the smaller of the two trees (the elements copied from other excepted) and keep the iterators on
+	// the remaining elements valid
+
+	// add the elements of other whose key is not in the tree
+	void set_union(const bst &other) {
+		(void)sizeof(bst_unique_keys_only<multi>);
+		if (&other == this || other.empty())
+			return;
+		if (few_keys(other.size(), this->size()))
+		{
+			for (const_iterator it = other.begin(); it != other.end(); ++it)
+				this->insert(*it);
+			return;
+		}
+		size_type h = black_height(this->super_root.l);
+		this->assign_root(this->union_tree(this->super_root.l, h, other.super_root.l, h));
+	}
+
+	// keep only the elements whose key is in other
+	void set_intersection(const bst &other) {
+		(void)sizeof(bst_unique_keys_only<multi>);
+		if (&other == this)
+			return;
+		if (this->size() <= other.size())
+			return this->filter_tree(other, true);
+		size_type h = black_height(this->super_root.l);
+		this->assign_root(this->intersection_tree(this->super_root.l, h, other.super_root.l, h));
+	}
+
+	// remove the elements whose key is in other
+	void set_difference(const bst &other) {
+		(void)sizeof(bst_unique_keys_only<multi>);
+		if (&other == this)
+			return this->clear();
+		if (this->size() <= other.size())
+			return this->filter_tree(other, false);
+		if (few_keys(other.size(), this->size()))
+		{
+			for (const_iterator it = other.begin(); it != other.end(); ++it)
+				this->erase(KeyOfValue()(*it));
+			return;
+		}
+		size_type h = black_height(this->super_root.l);
+		this->assign_root(this->difference_tree(this->super_root.l, h, other.super_root.l, h));
+	}
+
 	key_compare key_comp() const {return this->compare;}
 
 	value_compare value_comp() const {return this->_value_comp;}
@@ -370,36 +610,82 @@ public:
 	}
 private:
 
-	ft::pair<iterator , bool>	recursive_insert(node_type_base *& current, node_type_base *parent, const value_type& value)
+	// whether value can be placed right before n, or right after it (equal values can for multi trees)
+	bool	goes_before(const value_type &value, node_type_base *n) const
 	{
-		if (!current)
-		{
-			current = new_node(value);
-			current->p = parent;
-			if (parent == &this->super_root)
-				this->assign_tree(current);
-			if (parent == this->first && parent->l == current)
-				this->first = current;
-			if (parent == this->last && parent->r == current)
-				this->last = current;
-			ft::pair<iterator, bool> ret = ft::make_pair(iterator(current), true);
-			this->fix_insert(current);
-#ifdef DEBUG_BST_HPP
-			if (!this->rb_test())
-				this->print();
-#endif
-			return ret;
-		}
-		if (this->_value_comp(value, (static_cast<node_type*>(current)->value)))
-			return recursive_insert(current->l, current, value);
 		if (multi)
-			return recursive_insert(current->r, current, value);
-		else
+			return !this->_value_comp(static_cast<node_type *>(n)->value, value);
+		return this->_value_comp(value, static_cast<node_type *>(n)->value);
+	}
+
+	bool	goes_after(node_type_base *n, const value_type &value) const
+	{
+		if (multi)
+			return !this->_value_comp(value, static_cast<node_type *>(n)->value);
+		return this->_value_comp(static_cast<node_type *>(n)->value, value);
+	}
+
+	// insert value between the node before n and n (the super root standing for end()), there is always a free
+	// slot: the left of n or the right of the node before it
+	iterator	insert_before(node_type_base *n, const value_type &value)
+	{
+		if (n == &this->super_root)
+			return this->insert_from(&this->last->r, this->last, value).first;
+		if (!n->l)
+			return this->insert_from(&n->l, n, value).first;
+		node_type_base *prev = prev_node(n);
+		return this->insert_from(&prev->r, prev, value).first;
+	}
+
+	// insert value right after n if it belongs there and before the next node, otherwise search it from n
+	iterator	insert_after(node_type_base *n, const value_type &value)
+	{
+		node_type_base *next = next_node(n);
+		if (this->goes_after(n, value) &&
+			(next == &this->super_root || this->_value_comp(value, static_cast<node_type *>(next)->value)))
+			return this->insert_before(next, value);
+		return this->insert_search(n, value, false);
+	}
+
+	// insert value searched from n in O(log d), after its equals or before them with before_equals
+	iterator	insert_search(node_type_base *n, const value_type &value, bool before_equals)
+	{
+		n = this->finger(n, KeyOfValue()(value));
+		if (multi && before_equals)
+			return this->insert_before(this->lower_bound_in(n, KeyOfValue()(value)).current, value);
+		return this->insert_from(&n->ptr(), n->p, value).first;
+	}
+
+	// descend from the subtree in slot (a child pointer of parent) and insert value as a leaf
+	ft::pair<iterator , bool>	insert_from(node_type_base **slot, node_type_base *parent, const value_type& value)
+	{
+		while (*slot)
 		{
-			if (this->_value_comp((static_cast<node_type *>(current)->value), (value)))
-				return recursive_insert(current->r, current, value);
-			return ft::make_pair(iterator(current), false);
+			parent = *slot;
+			if (this->_value_comp(value, static_cast<node_type*>(parent)->value))
+				slot = &parent->l;
+			else if (multi || this->_value_comp(static_cast<node_type*>(parent)->value, value))
+				slot = &parent->r;
+			else
+				return ft::make_pair(iterator(parent), false);
 		}
+		node_type_base *current = new_node(value);
+		*slot = current;
+		current->p = parent;
+		if (parent == &this->super_root)
+			this->assign_tree(current);
+		if (parent == this->first && parent->l == current)
+			this->first = current;
+		if (parent == this->last && parent->r == current)
+			this->last = current;
+		this->add_weight(parent, 1, order_statistics());
+		ft::pair<iterator, bool> ret = ft::make_pair(iterator(current), true);
+		this->fix_insert(current);
+#ifdef DEBUG_BST_HPP
+		if (!this->rb_test())
+			this->print();
+#endif
+		return ret;
 	}
 
 	void	fix_insert(node_type_base *n)
@@ -460,6 +746,7 @@ private:
 			n = NULL;
 		if (ref.p == &this->super_root)
 			this->super_root.r = n;
+		this->add_weight(ref.p, -1, order_statistics());
 #ifdef DEBUG_BST_HPP
 		if (!rb_test())
 			print();
@@ -532,101 +819,229 @@ private:
 		}
 	}
 
-	size_type erase_multi(node_type_base *current, const Key &key)
+	template<class K>
+	size_type internal_rank(const K &key) const {
+		size_type ret = 0;
+		node_type_base *n = this->super_root.l;
+		while (n)
+		{
+			if (this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
+			{
+				ret += weight(n->l) + 1;
+				n = n->r;
+			}
+			else
+				n = n->l;
+		}
+		return ret;
+	}
+
+	// the first of the equal elements in multi trees, like the stl
+	template<class K>
+	node_type_base	*find_node(const K &key) const
 	{
-		if (!current)
-			return 0;
-		if (this->compare(key, KeyOfValue()(static_cast<node_type*>(current)->value)))
-			return this->erase_multi(current->l, key);
-		else if (this->compare(KeyOfValue()(static_cast<node_type*>(current)->value), key))
-			return this->erase_multi(current->r, key);
-		else if (multi)
-		{
-			size_type ret = 1 + this->erase_multi(current->l, key) + this->erase_multi(current->r, key);
-			this->erase_node(*current);
-			return ret;
+		node_type_base *current = this->super_root.l;
+		node_type_base *ret = NULL;
+		while (current)
+		{
+			if (this->compare(key, KeyOfValue()(static_cast<node_type*>(current)->value)))
+				current = current->l;
+			else if (this->compare(KeyOfValue()(static_cast<node_type*>(current)->value), key))
+				current = current->r;
+			else if (!multi)
+				return current;
+			else
+			{
+				ret = current;
+				current = current->l;
+			}
 		}
-		else
+		return ret;
+	}
+
+	// first node whose key is not less than key
+	template<class K>
+	iterator internal_lower_bound(const K& key) const
+	{
+		return this->lower_bound_in((node_type_base *)this->super_root.l, key);
+	}
+
+	iterator hinted_lower_bound(node_type_base *hint, const Key& key) const
+	{
+		if (this->empty())
+			return iterator(&this->super_root);
+		node_type_base *n = hint == &this->super_root ? this->last : hint;
+		// when the keys searched follow each other the result is the hint or the element after it
+		if (this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
 		{
-			this->erase_node(*current);
-			return 1;
+			node_type_base *next = next_node(n);
+			if (next == &this->super_root || !this->compare(KeyOfValue()(static_cast<node_type*>(next)->value), key))
+				return iterator(next);
 		}
+		else if (n == this->first || this->compare(KeyOfValue()(static_cast<node_type*>(prev_node(n))->value), key))
+			return iterator(n);
+		return this->lower_bound_in(this->finger(n, key), key);
 	}
 
-	size_type recursive_count(node_type_base *current, const Key &key) const
+	// first node of the subtree n whose key is not less than key, or the node following the subtree
+	template<class K>
+	iterator lower_bound_in(node_type_base *n, const K& key) const
 	{
-		if (!current)
-			return 0;
-		if (this->compare(key, KeyOfValue()(static_cast<node_type*>(current)->value)))
-			return this->recursive_count(current->l, key);
-		else if (this->compare(KeyOfValue()(static_cast<node_type*>(current)->value), key))
-			return this->recursive_count(current->r, key);
-		else if (multi)
-			return 1 + this->recursive_count(current->l, key) + this->recursive_count(current->r, key);
-		else
-			return 1;
+		node_type_base *ret = NULL;
+		node_type_base *last = (node_type_base *)&this->super_root;
+		while (n)
+		{
+			last = n;
+			if (!this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
+			{
+				ret = n;
+				n = n->l;
+			}
+			else
+				n = n->r;
+		}
+		if (!ret)
+			return iterator(last == &this->super_root ? last : next_node(last));
+		return iterator(ret);
 	}
 
-	node_type_base	*recursive_find(node_type_base *current, const Key &key) const
+	// the lowest ancestor of n (or n itself) whose subtree holds the elements of key and the position where key
+	// would be inserted: the walk up stops on an ancestor bounding the subtree strictly on the side of key, the
+	// search from there costs O(log d) where d is the distance from n to key
+	node_type_base *finger(node_type_base *n, const Key &key) const
 	{
-		if (!current)
-			return NULL;
-		if (this->compare(key, KeyOfValue()(static_cast<node_type*>(current)->value)))
-			return this->recursive_find(current->l, key);
-		else if (this->compare(KeyOfValue()(static_cast<node_type*>(current)->value), key))
-			return this->recursive_find(current->r, key);
+		if (this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
+		{
+			while (n->p != &this->super_root &&
+				(n->p->r == n || !this->compare(key, KeyOfValue()(static_cast<node_type*>(n->p)->value))))
+				n = n->p;
+		}
 		else
-			return current;
+		{
+			while (n->p != &this->super_root &&
+				(n->p->l == n || !this->compare(KeyOfValue()(static_cast<node_type*>(n->p)->value), key)))
+				n = n->p;
+		}
+		return n;
 	}
 
-	iterator internal_lower_bound(const Key& key) const
+	// first node whose key is greater than key
+	template<class K>
+	iterator internal_upper_bound(const K& key) const
 	{
 		node_type_base *n = (node_type_base *)this->super_root.l;
 		node_type_base *ret = (node_type_base *)&this->super_root;
 		while (n)
 		{
-			if ((ret == &this->super_root || !this->_value_comp(static_cast<node_type*>(ret)->value, static_cast<node_type*>(n)->value)) &&
-				!this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
+			if (this->compare(key, KeyOfValue()(static_cast<node_type*>(n)->value)))
+			{
 				ret = n;
-			if (this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
-				n = n->r;
-			else if (this->compare(key, KeyOfValue()(static_cast<node_type*>(n)->value)))
-				n = n->l;
-			else if (multi)
 				n = n->l;
+			}
 			else
-				return iterator(ret);
+				n = n->r;
 		}
 		return iterator(ret);
 	}
 
-	iterator internal_upper_bound(const Key& key) const
+	iterator internal_nth(size_type k) const
 	{
 		node_type_base *n = (node_type_base *)this->super_root.l;
-		node_type_base *ret = (node_type_base *)&this->super_root;
 		while (n)
 		{
-			if ((ret == &this->super_root || !this->_value_comp(static_cast<node_type*>(ret)->value, static_cast<node_type*>(n)->value)) &&
-				this->compare(key, KeyOfValue()(static_cast<node_type*>(n)->value)))
-				ret = n;
-			if (this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), key))
-				n = n->r;
-			else if (this->compare(key, KeyOfValue()(static_cast<node_type*>(n)->value)))
+			size_type left = weight(n->l);
+			if (k < left)
 				n = n->l;
+			else if (k == left)
+				return iterator(n);
 			else
+			{
+				k -= left + 1;
 				n = n->r;
+			}
 		}
-		return iterator(ret);
+		return iterator((node_type_base *)&this->super_root);
+	}
+
+	static size_type weight(const node_type_base *n)
+	{
+		return n ? n->weight : 0;
+	}
+
+	// recompute the weight of n from the ones of its children
+	static void	update_weight(node_type_base *n, ft::true_type)
+	{
+		n->weight = weight(n->l) + weight(n->r) + 1;
+	}
+
+	static void	update_weight(node_type_base *, ft::false_type) {}
+
+	// add delta to the weight of n and of all its ancestors
+	void	add_weight(node_type_base *n, difference_type delta, ft::true_type)
+	{
+		for (; n != &this->super_root; n = n->p)
+			n->weight += delta;
+	}
+
+	void	add_weight(node_type_base *, difference_type, ft::false_type) {}
+
+	static void	swap_weight(node_type_base *a, node_type_base *b, ft::true_type)
+	{
+		ft::swap(a->weight, b->weight);
 	}
 
+	static void	swap_weight(node_type_base *, node_type_base *, ft::false_type) {}
+
 	node_type *new_node(const node_type &val)
 	{
-		node_type *ret = this->allocator.allocate(1);
+		node_type *ret = this->take_node();
 		this->allocator.construct(ret, val);
 		this->_size++;
 		return ret;
 	}
 
+	// storage for a node: a previously erased one, or the next one of the current chunk
+	node_type *take_node()
+	{
+		if (this->free_nodes)
+		{
+			free_node *ret = this->free_nodes;
+			this->free_nodes = ret->next;
+			return reinterpret_cast<node_type *>(ret);
+		}
+		if (this->bump == this->bump_end)
+			this->add_chunk();
+		return this->bump++;
+	}
+
+	// chunks double in size up to MAX_CHUNK nodes
+	void	add_chunk()
+	{
+		size_type count = MIN_CHUNK;
+		if (this->chunks)
+			count = ft::min<size_type>(this->chunks->count * 2, MAX_CHUNK);
+		node_type *slots = this->allocator.allocate(count + 1);
+		node_chunk *chunk = reinterpret_cast<node_chunk *>(slots);
+		chunk->next = this->chunks;
+		chunk->count = count;
+		this->chunks = chunk;
+		this->bump = slots + 1;
+		this->bump_end = slots + 1 + count;
+	}
+
+	void	release_chunks()
+	{
+		while (this->chunks)
+		{
+			node_chunk *next = this->chunks->next;
+			this->allocator.deallocate(reinterpret_cast<node_type *>(this->chunks), this->chunks->count + 1);
+			this->chunks = next;
+		}
+		this->free_nodes = NULL;
+		this->bump = NULL;
+		this->bump_end = NULL;
+	}
+
 	void	assign_tree(node_type_base *tree)
 	{
 		this->super_root.l = tree;
@@ -643,41 +1058,413 @@ private:
 	void	destroy_node(node_type_base &node)
 	{
 		this->allocator.destroy(static_cast<node_type*>(&node));
-		this->allocator.deallocate(static_cast<node_type*>(&node), 1);
 		this->_size--;
+		if (!this->_size)
+			return this->release_chunks();
+		free_node *f = reinterpret_cast<free_node *>(static_cast<node_type*>(&node));
+		f->next = this->free_nodes;
+		this->free_nodes = f;
 	}
 
-	node_type_base *copy_tree(const bst& other_bst, const node_type_base *other)
+	node_type_base *copy_tree(const node_type_base *other)
 	{
 		if (!other)
 			return NULL;
 		node_type_base *ret = new_node(*static_cast<const node_type*>(other));
 		if (ret->r)
 		{
-			ret->r = copy_tree(other_bst, ret->r);
+			ret->r = copy_tree(ret->r);
 			ret->r->p = ret;
 		}
 		if (ret->l)
 		{
-			ret->l = copy_tree(other_bst, ret->l);
+			ret->l = copy_tree(ret->l);
 			ret->l->p = ret;
 		}
-		if (other_bst.first == other)
-			this->first = ret;
-		if (other_bst.last == other)
-			this->last = ret;
 		return ret;
 	}
 
-	void	destroy_tree(node_type_base *tree)
+	// build the tree (which must be empty) from the longest sorted prefix of [f, l), f is left on the rest
+	template<class InputIt>
+	void	build_sorted_prefix(InputIt &f, InputIt l)
+	{
+		node_type_base *head = NULL;
+		node_type_base *tail = NULL;
+		for (; f != l; f++)
+		{
+			value_type value = *f;
+			if (tail)
+			{
+				if (this->_value_comp(value, static_cast<node_type *>(tail)->value))
+					break;
+				if (!multi && !this->_value_comp(static_cast<node_type *>(tail)->value, value))
+					continue;
+			}
+			tail = this->chain_node(head, tail, this->new_node(value));
+		}
+		this->assign_chain(head, tail, this->_size);
+	}
+
+	// chain n after tail through the r pointers
+	node_type_base	*chain_node(node_type_base *&head, node_type_base *tail, node_type_base *n)
+	{
+		n->l = NULL;
+		n->r = NULL;
+		if (tail)
+			tail->r = n;
+		else
+			head = n;
+		return n;
+	}
+
+	// make the tree from the count nodes chained from head to tail, the deepest level of a tree built
+	// by halving is the only incomplete one, coloring it red keeps the same black height everywhere
+	void	assign_chain(node_type_base *head, node_type_base *tail, size_type count)
+	{
+		size_type red_depth = 0;
+		while (red_depth < sizeof(size_type) * 8 - 1 && ((size_type)2 << red_depth) <= count)
+			red_depth++;
+		node_type_base *list = head;
+		this->assign_tree(this->build_tree(list, count, 0, red_depth));
+		if (head)
+		{
+			this->first = head;
+			this->last = tail;
+		}
+	}
+
+	// link the next count nodes of the chain list into a balanced subtree
+	node_type_base	*build_tree(node_type_base *&list, size_type count, size_type depth, size_type red_depth)
+	{
+		if (!count)
+			return NULL;
+		node_type_base *left = this->build_tree(list, count / 2, depth + 1, red_depth);
+		node_type_base *root = list;
+		list = list->r;
+		root->l = left;
+		if (left)
+			left->p = root;
+		root->r = this->build_tree(list, count - count / 2 - 1, depth + 1, red_depth);
+		if (root->r)
+			root->r->p = root;
+		root->color = depth && depth == red_depth ? RED : BLACK;
+		update_weight(root, order_statistics());
+		return root;
+	}
+
+	// count keys are faster inserted or erased one by one than split in a tree of size elements
+	static bool	few_keys(size_type count, size_type size)
+	{
+		size_type log = 0;
+		while (size >> log > 1)
+			log++;
+		return count * log < size;
+	}
+
+	// assign_tree, with first and last found at the ends of the tree
+	void	assign_root(node_type_base *tree)
+	{
+		this->assign_tree(tree);
+		if (!tree)
+			return;
+		for (this->first = tree; this->first->l; this->first = this->first->l);
+		for (this->last = tree; this->last->r; this->last = this->last->r);
+	}
+
+	// number of black nodes on the paths from n to its leaves, n included
+	static size_type	black_height(const node_type_base *n)
+	{
+		size_type ret = 0;
+		for (; n; n = n->l)
+			ret += n->color == BLACK;
+		return ret;
+	}
+
+	// make l and r the children of k
+	node_type_base	*link(node_type_base *l, node_type_base *k, node_type_base *r, e_color color)
+	{
+		k->l = l;
+		k->r = r;
+		if (l)
+			l->p = k;
+		if (r)
+			r->p = k;
+		k->color = color;
+		update_weight(k, order_statistics());
+		return k;
+	}
+
+	// rotate a subtree which is not (yet) attached to the tree, n goes down in direction
+	node_type_base	*rotate_subtree(node_type_base *n, int direction)
+	{
+		node_type_base *top = n->childs[1 - direction];
+		n->childs[1 - direction] = top->childs[direction];
+		if (top->childs[direction])
+			top->childs[direction]->p = n;
+		top->childs[direction] = n;
+		n->p = top;
+		update_weight(n, order_statistics());
+		update_weight(top, order_statistics());
+		return top;
+	}
+
+	// the subtrees below are handled with their black height (see black_height), a subtree may have a red root
+	// but never a red child under it
+
+	// hang k and small on the side spine of big, at the first black node with the black height of small
+	node_type_base	*join_side(node_type_base *big, size_type hb, node_type_base *k, node_type_base *small, size_type hs, int side)
+	{
+		if (hb == hs && (!big || big->color == BLACK))
+			return side == RIGHT ? this->link(big, k, small, RED) : this->link(small, k, big, RED);
+		node_type_base *child = this->join_side(big->childs[side], hb - (big->color == BLACK), k, small, hs, side);
+		big->childs[side] = child;
+		child->p = big;
+		update_weight(big, order_statistics());
+		if (big->color == BLACK && child->color == RED && child->childs[side] && child->childs[side]->color == RED)
+		{
+			child->childs[side]->color = BLACK;
+			return this->rotate_subtree(big, 1 - side);
+		}
+		return big;
+	}
+
+	// join l < k < r in O(|hl - hr| + 1), h is set to the black height of the result
+	node_type_base	*join(node_type_base *l, size_type hl, node_type_base *k, node_type_base *r, size_type hr, size_type &h)
+	{
+		node_type_base *ret;
+		int side;
+		if (hl == hr)
+		{
+			h = hl;
+			if ((!l || l->color == BLACK) && (!r || r->color == BLACK))
+				return this->link(l, k, r, RED);
+			h++;
+			return this->link(l, k, r, BLACK);
+		}
+		if (hl > hr)
+		{
+			h = hl;
+			side = RIGHT;
+			ret = this->join_side(l, hl, k, r, hr, RIGHT);
+		}
+		else
+		{
+			h = hr;
+			side = LEFT;
+			ret = this->join_side(r, hr, k, l, hl, LEFT);
+		}
+		if (ret->color == RED && ret->childs[side] && ret->childs[side]->color == RED)
+		{
+			ret->color = BLACK;
+			h++;
+		}
+		return ret;
+	}
+
+	// join l < r
+	node_type_base	*join(node_type_base *l, size_type hl, node_type_base *r, size_type hr, size_type &h)
+	{
+		if (!l || !r)
+		{
+			h = l ? hl : hr;
+			return l ? l : r;
+		}
+		node_type_base *rest;
+		size_type hrest;
+		node_type_base *k = this->split_last(l, hl, rest, hrest);
+		return this->join(rest, hrest, k, r, hr, h);
+	}
+
+	// split t in the keys less than key (l) and greater than key (r), the node of key (if any) is returned
+	node_type_base	*split(node_type_base *t, size_type h, const Key &key, node_type_base *&l, size_type &hl,
+		node_type_base *&r, size_type &hr)
+	{
+		if (!t)
+		{
+			l = NULL;
+			r = NULL;
+			hl = 0;
+			hr = 0;
+			return NULL;
+		}
+		node_type_base *tl = t->l;
+		node_type_base *tr = t->r;
+		size_type hc = h - (t->color == BLACK);
+		node_type_base *ret = t;
+		if (this->compare(key, KeyOfValue()(static_cast<node_type*>(t)->value)))
+		{
+			ret = this->split(tl, hc, key, l, hl, r, hr);
+			r = this->join(r, hr, t, tr, hc, hr);
+		}
+		else if (this->compare(KeyOfValue()(static_cast<node_type*>(t)->value), key))
+		{
+			ret = this->split(tr, hc, key, l, hl, r, hr);
+			l = this->join(tl, hc, t, l, hl, hl);
+		}
+		else
+		{
+			l = tl;
+			r = tr;
+			hl = hc;
+			hr = hc;
+		}
+		return ret;
+	}
+
+	// take the last node out of t
+	node_type_base	*split_last(node_type_base *t, size_type h, node_type_base *&rest, size_type &hrest)
+	{
+		size_type hc = h - (t->color == BLACK);
+		if (!t->r)
+		{
+			rest = t->l;
+			hrest = hc;
+			return t;
+		}
+		node_type_base *tl = t->l;
+		node_type_base *ret = this->split_last(t->r, hc, rest, hrest);
+		rest = this->join(tl, hc, t, rest, hrest, hrest);
+		return ret;
+	}
+
+	// the three set operations walk other, split t at each of its keys and join the results back
+
+	node_type_base	*union_tree(node_type_base *t, size_type ht, const node_type_base *o, size_type &h)
+	{
+		if (!o)
+		{
+			h = ht;
+			return t;
+		}
+		if (!t)
+		{
+			t = this->copy_tree(o);
+			h = black_height(t);
+			return t;
+		}
+		node_type_base *l;
+		node_type_base *r;
+		size_type hl;
+		size_type hr;
+		node_type_base *k = this->split(t, ht, KeyOfValue()(static_cast<const node_type*>(o)->value), l, hl, r, hr);
+		if (!k)
+			k = this->new_node(*static_cast<const node_type*>(o));
+		l = this->union_tree(l, hl, o->l, hl);
+		r = this->union_tree(r, hr, o->r, hr);
+		return this->join(l, hl, k, r, hr, h);
+	}
+
+	node_type_base	*intersection_tree(node_type_base *t, size_type ht, const node_type_base *o, size_type &h)
+	{
+		if (!t || !o)
+		{
+			this->destroy_subtree(t);
+			h = 0;
+			return NULL;
+		}
+		node_type_base *l;
+		node_type_base *r;
+		size_type hl;
+		size_type hr;
+		node_type_base *k = this->split(t, ht, KeyOfValue()(static_cast<const node_type*>(o)->value), l, hl, r, hr);
+		l = this->intersection_tree(l, hl, o->l, hl);
+		r = this->intersection_tree(r, hr, o->r, hr);
+		if (k)
+			return this->join(l, hl, k, r, hr, h);
+		return this->join(l, hl, r, hr, h);
+	}
+
+	node_type_base	*difference_tree(node_type_base *t, size_type ht, const node_type_base *o, size_type &h)
+	{
+		if (!t || !o)
+		{
+			h = ht;
+			return t;
+		}
+		node_type_base *l;
+		node_type_base *r;
+		size_type hl;
+		size_type hr;
+		node_type_base *k = this->split(t, ht, KeyOfValue()(static_cast<const node_type*>(o)->value), l, hl, r, hr);
+		l = this->difference_tree(l, hl, o->l, hl);
+		r = this->difference_tree(r, hr, o->r, hr);
+		if (k)
+			this->destroy_node(*k);
+		return this->join(l, hl, r, hr, h);
+	}
+
+	// when the tree is the smaller one, look its keys up in other and rebuild it from the kept nodes
+	void	filter_tree(const bst &other, bool keep_found)
+	{
+		node_type_base *head = NULL;
+		node_type_base *tail = NULL;
+		this->filter_tree(this->super_root.l, other, keep_found, head, tail);
+		this->assign_chain(head, tail, this->_size);
+	}
+
+	void	filter_tree(node_type_base *n, const bst &other, bool keep_found, node_type_base *&head, node_type_base *&tail)
+	{
+		if (!n)
+			return;
+		node_type_base *r = n->r;
+		this->filter_tree(n->l, other, keep_found, head, tail);
+		if ((other.find_node(KeyOfValue()(static_cast<node_type*>(n)->value)) != NULL) == keep_found)
+			tail = this->chain_node(head, tail, n);
+		else
+			this->destroy_node(*n);
+		this->filter_tree(r, other, keep_found, head, tail);
+	}
+
+	void	destroy_subtree(node_type_base *n)
+	{
+		if (!n)
+			return;
+		node_type_base *r = n->r;
+		this->destroy_subtree(n->l);
+		this->destroy_node(*n);
+		this->destroy_subtree(r);
+	}
+
+	// destroy the values of a tree, its nodes are left to release_chunks
+	void	destroy_tree(node_type_base *tree, ft::false_type)
 	{
 		if (!tree)
 			return;
 		if (tree->l)
-			destroy_tree(tree->l);
+			destroy_tree(tree->l, ft::false_type());
 		if (tree->r)
-			destroy_tree(tree->r);
-		destroy_node(*tree);
+			destroy_tree(tree->r, ft::false_type());
+		this->allocator.destroy(static_cast<node_type*>(tree));
+	}
+
+	void	destroy_tree(node_type_base *, ft::true_type) {}
+
+	// the stack holds the nodes whose left subtree is being visited, a missing bound is not checked
+	template<class Reference, class Function>
+	Function visit(const Key *lo, const Key *hi, Function fn) const
+	{
+		node_type_base *stack[MAX_HEIGHT];
+		size_type top = 0;
+		for (node_type_base *n = this->super_root.l; n;)
+		{
+			if (lo && this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), *lo))
+				n = n->r;
+			else
+			{
+				stack[top++] = n;
+				n = n->l;
+			}
+		}
+		while (top)
+		{
+			node_type_base *n = stack[--top];
+			if (hi && !this->compare(KeyOfValue()(static_cast<node_type*>(n)->value), *hi))
+				break;
+			fn(static_cast<Reference>(static_cast<node_type*>(n)->value));
+			for (n = n->r; n; n = n->l)
+				stack[top++] = n;
+		}
+		return fn;
 	}
 
 	static node_type_base *next_node(node_type_base *n)
@@ -760,6 +1547,7 @@ private:
 		if (a->l)
 			a->l->p = a;
 		ft::swap(a->color, b->color);
+		swap_weight(a, b, order_statistics());
 
 		if (a->p == &this->super_root)
 			this->assign_tree(a);
@@ -786,6 +1574,8 @@ private:
 		n->childs[opposite] = rl;
 		if (rl)
 			rl->p = n;
+		update_weight(n, order_statistics());
+		update_weight(n->p, order_statistics());
 		if (this->super_root.l == n->p)
 			this->assign_tree(n->p);
 		return n->p;
@@ -815,8 +1605,21 @@ public:
 			std::cout << "!!!!!!! NOT IN RB-SHAPE !!!!!!!!" << std::endl;
 			return (0);
 		}
+		if (!weight_test(this->super_root.l, order_statistics()))
+		{
+			std::cout << "wrong subtree weight" << std::endl;
+			return (0);
+		}
 		return (1);
 	}
+	bool	weight_test(node_type_base *n, ft::true_type) const
+	{
+		if (!n)
+			return true;
+		return n->weight == weight(n->l) + weight(n->r) + 1 && weight_test(n->l, ft::true_type())
+			&& weight_test(n->r, ft::true_type());
+	}
+	bool	weight_test(node_type_base *, ft::false_type) const { return true; }
 		int is_rb_shaped(node_type_base *n) const
 		{
 			if (!n)
@@ -900,10 +1703,11 @@ template<
 		class	Compare,
 		class	Allocator,
 		bool	multi,
-		class	KeyOfValue
+		class	KeyOfValue,
+		bool	OrderStatistics
 >
-void swap( bst<Key, Value, Compare, Allocator, multi, KeyOfValue>& lhs,
-		   bst<Key, Value, Compare, Allocator, multi, KeyOfValue>& rhs )
+void swap( bst<Key, Value, Compare, Allocator, multi, KeyOfValue, OrderStatistics>& lhs,
+		   bst<Key, Value, Compare, Allocator, multi, KeyOfValue, OrderStatistics>& rhs )
 {
 	lhs.swap(rhs);
 }
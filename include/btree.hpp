@@ -0,0 +1,932 @@
+#ifndef FT_CONTAINERS_BTREE_HPP
+#define FT_CONTAINERS_BTREE_HPP
+#include "utility.hpp"
+#include "iterator.hpp"
+#include <memory>
+#include <cstddef>
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "type_traits.hpp"
+#ifdef DEBUG_BTREE_HPP
+# include <iostream>
+#endif
+
+// only defined when the values of a node fit in its unsigned short position and count, a NodeSize
+// holding more of them does not compile
+template<bool fits>
+struct btree_slots_fit;
+
+template<>
+struct btree_slots_fit<true> {};
+
+// b-tree whose nodes hold as many values as fit in NodeSize bytes, a lookup touches one node per level instead of
+// one per value. the values move between nodes when they split or merge: unlike with the bst, inserting or erasing
+// an element invalidates the iterators
+template<
+		class	Key,
+		class	Value,
+		class	Compare = ft::less <Key>,
+		class	Allocator = std::allocator <Key>,
+		bool	multi = false,
+		class	KeyOfValue = ft::identity,
+		size_t	NodeSize = 256
+>
+class btree {
+public:
+	typedef Key									key_type;
+	typedef Value								value_type;
+	typedef size_t								size_type;
+	typedef ptrdiff_t							difference_type;
+	typedef Allocator							allocator_type;
+	typedef value_type&							reference;
+	typedef const value_type&					const_reference;
+	typedef typename Allocator::pointer			pointer;
+	typedef typename Allocator::const_pointer	const_pointer;
+	typedef Compare								key_compare;
+	class value_compare {
+	public:
+		typedef bool		result_type;
+		typedef value_type	first_argument_type;
+		typedef value_type	second_argument_type;
+		Compare comp;
+		value_compare() : comp() {}
+		value_compare( Compare c ) : comp(c) {}
+		bool operator()( const value_type& lhs, const value_type& rhs ) const
+		{
+			return this->comp(KeyOfValue()(lhs), KeyOfValue()(rhs));
+		}
+	};
+private:
+	// values per node (at least 3), a node other than the root is rebalanced when it has less than MIN_SLOTS
+	enum e_node {
+		SLOTS = NodeSize > sizeof(void *) * 2 + sizeof(Value) * 3 ? (NodeSize - sizeof(void *) * 2) / sizeof(Value) : 3,
+		MIN_SLOTS = SLOTS / 2,
+		SLOTS_FIT = sizeof(btree_slots_fit<SLOTS <= (unsigned short)-1>)
+	};
+	typedef typename ft::is_trivially_copyable<value_type>::type trivial_values;
+	struct node_type {
+		node_type		*parent;
+		unsigned short	position;
+		unsigned short	count;
+		bool			leaf;
+		char			storage[SLOTS * sizeof(Value)] __attribute__((aligned(__alignof__(Value))));
+		value_type &value(int i) { return reinterpret_cast<value_type *>(this->storage)[i]; }
+		const value_type &value(int i) const { return reinterpret_cast<const value_type *>(this->storage)[i]; }
+	};
+	struct internal_node_type : public node_type {
+		node_type		*children[SLOTS + 1];
+	};
+	template<typename pointed_type>
+	struct iterator_t {
+		typedef ptrdiff_t difference_type;
+		typedef btree::value_type value_type;
+		typedef pointed_type *pointer;
+		typedef pointed_type &reference;
+		typedef ft::bidirectional_iterator_tag iterator_category;
+
+		btree::node_type *node;
+		int position;
+
+		iterator_t() : node(NULL), position(0) {}
+
+		iterator_t(const btree::node_type *n, int pos) : node((btree::node_type *)n), position(pos) {}
+
+		template <class other_type>
+		iterator_t(iterator_t<other_type> const &other) : node(other.node), position(other.position) {}
+
+		iterator_t &operator++() {
+			next_position(this->node, this->position);
+			return *this;
+		}
+
+		iterator_t operator++(int) {
+			iterator_t ret = *this;
+			next_position(this->node, this->position);
+			return ret;
+		}
+
+		iterator_t &operator--() {
+			prev_position(this->node, this->position);
+			return *this;
+		}
+
+		iterator_t operator--(int) {
+			iterator_t ret = *this;
+			prev_position(this->node, this->position);
+			return ret;
+		};
+
+		reference operator*() const { return this->node->value(this->position); }
+
+		pointer operator->() const { return &this->node->value(this->position); }
+
+	};
+public:
+	template<typename LT, typename RT>
+	friend bool operator==(iterator_t<LT> l, iterator_t<RT> r) { return l.node == r.node && l.position == r.position; }
+
+	template<typename LT, typename RT>
+	friend bool operator!=(iterator_t<LT> l, iterator_t<RT> r) { return !(l == r); }
+
+	typedef iterator_t<value_type> iterator;
+	typedef iterator_t<const value_type> const_iterator;
+	typedef ft::reverse_iterator<iterator> reverse_iterator;
+	typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+private:
+	Compare compare;
+	value_compare _value_comp;
+	size_type _size;
+	allocator_type allocator;
+	typename allocator_type::template rebind<node_type>::other leaf_allocator;
+	typename allocator_type::template rebind<internal_node_type>::other internal_allocator;
+	node_type *root;
+	node_type *leftmost;
+	node_type *rightmost;
+public:
+	btree() : compare(), _value_comp(compare), _size(), allocator(), leaf_allocator(), internal_allocator(), root(NULL),
+	leftmost(NULL), rightmost(NULL) {}
+
+	explicit btree(const Compare &comp, const Allocator &alloc = Allocator()) : compare(comp), _value_comp(comp), _size(),
+	allocator(alloc), leaf_allocator(alloc), internal_allocator(alloc), root(NULL), leftmost(NULL), rightmost(NULL) {}
+
+	template<class InputIt>
+	btree(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) : compare(
+			comp), _value_comp(comp), _size(), allocator(alloc), leaf_allocator(alloc), internal_allocator(alloc),
+			root(NULL), leftmost(NULL), rightmost(NULL) {
+		this->insert(first, last);
+	}
+
+	btree(const btree &other) : compare(other.compare), _value_comp(other._value_comp), _size(0),
+	allocator(other.allocator), leaf_allocator(other.leaf_allocator), internal_allocator(other.internal_allocator),
+	root(NULL), leftmost(NULL), rightmost(NULL) {
+		*this = other;
+	}
+
+	~btree() {
+		this->clear();
+	}
+
+	btree &operator=(const btree &other) {
+		if (&other == this)
+			return *this;
+		this->clear();
+		this->compare = other.compare;
+		this->_value_comp = other._value_comp;
+		this->allocator = other.allocator;
+		this->leaf_allocator = other.leaf_allocator;
+		this->internal_allocator = other.internal_allocator;
+		if (!other.root)
+			return *this;
+		this->root = this->copy_node(other.root, NULL);
+		this->leftmost = this->root;
+		while (!this->leftmost->leaf)
+			this->leftmost = child(this->leftmost, 0);
+		this->rightmost = this->root;
+		while (!this->rightmost->leaf)
+			this->rightmost = child(this->rightmost, this->rightmost->count);
+		this->_size = other._size;
+		return *this;
+	}
+
+	allocator_type get_allocator() const { return this->allocator; }
+
+	iterator begin() { return iterator(this->leftmost, 0); }
+
+	const_iterator begin() const { return const_iterator(this->leftmost, 0); }
+
+	iterator end() { return this->end_position(); }
+
+	const_iterator end() const { return this->end_position(); }
+
+	reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+	const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+	reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+	const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+	bool empty() const { return this->_size == 0; }
+
+	size_type size() const { return this->_size; }
+
+	size_type max_size() const { return this->allocator.max_size(); };
+
+	void clear() {
+		if (this->root)
+			this->destroy_tree(this->root);
+		this->root = NULL;
+		this->leftmost = NULL;
+		this->rightmost = NULL;
+		this->_size = 0;
+	}
+
+	typename ft::conditional<multi, iterator, ft::pair<iterator, bool> >::type insert(const value_type &value) {
+		return this->insert(value, ft::integral_constant<bool, !multi>());
+	}
+private:
+	ft::pair<iterator, bool> insert(const value_type &value, ft::true_type) {
+		if (!this->root)
+			return ft::make_pair(this->insert_first(value), true);
+		node_type *n = this->root;
+		for (;;)
+		{
+			int i = this->node_lower_bound(n, KeyOfValue()(value));
+			if (i < n->count && !this->_value_comp(value, n->value(i)))
+				return ft::make_pair(iterator(n, i), false);
+			if (n->leaf)
+				return ft::make_pair(this->insert_leaf(n, i, value), true);
+			n = child(n, i);
+		}
+	}
+
+	iterator insert(const value_type &value, ft::false_type) {
+		if (!this->root)
+			return this->insert_first(value);
+		node_type *n = this->root;
+		for (;;)
+		{
+			int i = this->node_upper_bound(n, KeyOfValue()(value));
+			if (n->leaf)
+				return this->insert_leaf(n, i, value);
+			n = child(n, i);
+		}
+	}
+public:
+	iterator insert(iterator pos, const value_type &value) {
+		iterator prev = pos;
+		if (multi)
+		{
+			// as close to pos as possible: before it if prev <= value <= pos, after it if pos < value <= next
+			if (pos == this->end() || !this->_value_comp(*pos, value))
+			{
+				if (pos == this->begin() || !this->_value_comp(value, *--prev))
+					return this->insert_before(pos, value);
+				return this->insert(value, ft::false_type());
+			}
+			iterator next = pos;
+			if (++next == this->end() || !this->_value_comp(*next, value))
+				return this->insert_before(next, value);
+			return this->insert_before(this->lower_bound(KeyOfValue()(value)), value);
+		}
+		// if prev < value < pos
+		if ((pos == this->end() || this->_value_comp(value, *pos)) &&
+			(pos == this->begin() || this->_value_comp(*--prev, value)))
+			return this->insert_before(pos, value);
+		return this->insert(value, ft::true_type()).first;
+	}
+
+	// sorted input is appended without searching
+	template<class InputIt>
+	void insert(InputIt f, InputIt l) {
+		for (; f != l; f++)
+			this->insert(this->end(), (value_type)*f);
+	}
+
+	void erase(iterator pos) {
+		this->erase_at(pos);
+	}
+
+	void erase(iterator f, iterator l) {
+		if (f == this->begin() && l == this->end())
+			return this->clear();
+		for (size_type n = ft::distance(f, l); n; n--)
+			f = this->erase_at(f);
+	}
+
+	size_type erase(const Key &key) {
+		if (!multi)
+		{
+			iterator it = this->find(key);
+			if (it == this->end())
+				return 0;
+			this->erase_at(it);
+			return 1;
+		}
+		ft::pair<iterator, iterator> range = this->equal_range(key);
+		size_type ret = ft::distance(range.first, range.second);
+		this->erase(range.first, range.second);
+		return ret;
+	}
+
+	void swap(btree &other) {
+		ft::swap(this->compare, other.compare);
+		ft::swap(this->_value_comp, other._value_comp);
+		ft::swap(this->_size, other._size);
+		ft::swap(this->allocator, other.allocator);
+		ft::swap(this->leaf_allocator, other.leaf_allocator);
+		ft::swap(this->internal_allocator, other.internal_allocator);
+		ft::swap(this->root, other.root);
+		ft::swap(this->leftmost, other.leftmost);
+		ft::swap(this->rightmost, other.rightmost);
+	}
+
+	size_type count(const Key &key) const {
+		if (!multi)
+			return this->find(key) != this->end();
+		ft::pair<const_iterator, const_iterator> range = this->equal_range(key);
+		return ft::distance(range.first, range.second);
+	}
+
+	iterator find(const Key &key) {
+		return this->internal_find(key);
+	}
+
+	const_iterator find(const Key &key) const
+	{
+		return this->internal_find(key);
+	}
+
+	ft::pair<iterator,iterator> equal_range( const Key& key )
+	{
+		return ft::make_pair<iterator,iterator>(this->lower_bound(key), this->upper_bound(key));
+	}
+
+	ft::pair<const_iterator,const_iterator> equal_range( const Key& key ) const
+	{
+		return ft::make_pair<const_iterator,const_iterator>(this->lower_bound(key), this->upper_bound(key));
+	}
+
+	iterator upper_bound( const Key& key ) {
+		return internal_upper_bound(key);
+	}
+
+	const_iterator upper_bound( const Key& key ) const {
+		return internal_upper_bound(key);
+	}
+
+	iterator lower_bound( const Key& key ) {
+		return internal_lower_bound(key);
+	}
+
+	const_iterator lower_bound( const Key& key ) const {
+		return internal_lower_bound(key);
+	}
+
+	key_compare key_comp() const {return this->compare;}
+
+	value_compare value_comp() const {return this->_value_comp;}
+
+	friend bool operator==(const btree &lhs, const btree &rhs) {
+		return ((lhs.size() == rhs.size()) && ft::equal<const_iterator, const_iterator>(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+	friend bool operator!=(const btree &lhs, const btree &rhs) {
+		return (!(lhs == rhs));
+	}
+	friend bool operator<(const btree &lhs, const btree &rhs) {
+		return (ft::lexicographical_compare<const_iterator, const_iterator>(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+	friend bool operator<=(const btree &lhs, const btree &rhs) {
+		return (!(rhs < lhs));
+	}
+	friend bool operator>(const btree &lhs, const btree &rhs) {
+		return (rhs < lhs);
+	}
+	friend bool operator>=(const btree &lhs, const btree &rhs) {
+		return (!(lhs < rhs));
+	}
+private:
+	static node_type *&child(const node_type *n, int i)
+	{
+		return const_cast<internal_node_type *>(static_cast<const internal_node_type *>(n))->children[i];
+	}
+
+	static void	set_child(node_type *n, int i, node_type *c)
+	{
+		child(n, i) = c;
+		c->parent = n;
+		c->position = i;
+	}
+
+	// the position following the value at pos in n, the end of the tree is the position past the last value of the
+	// rightmost leaf
+	static void	next_position(node_type *&n, int &pos)
+	{
+		if (!n->leaf)
+		{
+			n = child(n, pos + 1);
+			while (!n->leaf)
+				n = child(n, 0);
+			pos = 0;
+			return;
+		}
+		if (++pos < n->count)
+			return;
+		climb_right(n, pos);
+	}
+
+	// from the position past the last value of a leaf to the value following it in an ancestor, if there is one
+	static void	climb_right(node_type *&n, int &pos)
+	{
+		node_type *up = n;
+		int up_pos = pos;
+		while (up_pos == up->count && up->parent)
+		{
+			up_pos = up->position;
+			up = up->parent;
+		}
+		if (up_pos < up->count)
+		{
+			n = up;
+			pos = up_pos;
+		}
+	}
+
+	static void	prev_position(node_type *&n, int &pos)
+	{
+		if (!n->leaf)
+		{
+			n = child(n, pos);
+			while (!n->leaf)
+				n = child(n, n->count);
+			pos = n->count - 1;
+			return;
+		}
+		if (--pos >= 0)
+			return;
+		node_type *up = n;
+		int up_pos = pos;
+		while (up_pos < 0 && up->parent)
+		{
+			up_pos = up->position - 1;
+			up = up->parent;
+		}
+		if (up_pos >= 0)
+		{
+			n = up;
+			pos = up_pos;
+		}
+	}
+
+	// index of the first value of n whose key is not less than key
+	int		node_lower_bound(const node_type *n, const Key &key) const
+	{
+		int lo = 0;
+		int hi = n->count;
+		while (lo < hi)
+		{
+			int mid = (lo + hi) / 2;
+			if (this->compare(KeyOfValue()(n->value(mid)), key))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	// index of the first value of n whose key is greater than key
+	int		node_upper_bound(const node_type *n, const Key &key) const
+	{
+		int lo = 0;
+		int hi = n->count;
+		while (lo < hi)
+		{
+			int mid = (lo + hi) / 2;
+			if (!this->compare(key, KeyOfValue()(n->value(mid))))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	iterator	end_position() const
+	{
+		return iterator(this->rightmost, this->rightmost ? this->rightmost->count : 0);
+	}
+
+	// the bound found in a node is the result unless a closer one is found in the child before it
+	iterator	internal_lower_bound(const Key &key) const
+	{
+		iterator ret = this->end_position();
+		node_type *n = this->root;
+		while (n)
+		{
+			int i = this->node_lower_bound(n, key);
+			if (i < n->count)
+				ret = iterator(n, i);
+			n = n->leaf ? NULL : child(n, i);
+		}
+		return ret;
+	}
+
+	iterator	internal_upper_bound(const Key &key) const
+	{
+		iterator ret = this->end_position();
+		node_type *n = this->root;
+		while (n)
+		{
+			int i = this->node_upper_bound(n, key);
+			if (i < n->count)
+				ret = iterator(n, i);
+			n = n->leaf ? NULL : child(n, i);
+		}
+		return ret;
+	}
+
+	// unique trees stop on the first equal key met
+	iterator	internal_find(const Key &key) const
+	{
+		if (multi)
+		{
+			iterator ret = this->internal_lower_bound(key);
+			if (ret == this->end_position() || this->compare(key, KeyOfValue()(*ret)))
+				return this->end_position();
+			return ret;
+		}
+		node_type *n = this->root;
+		while (n)
+		{
+			int i = this->node_lower_bound(n, key);
+			if (i < n->count && !this->compare(key, KeyOfValue()(n->value(i))))
+				return iterator(n, i);
+			n = n->leaf ? NULL : child(n, i);
+		}
+		return this->end_position();
+	}
+
+	iterator	insert_first(const value_type &value)
+	{
+		this->root = this->new_node(true);
+		this->leftmost = this->root;
+		this->rightmost = this->root;
+		return this->insert_leaf(this->root, 0, value);
+	}
+
+	// insert value right before the element at pos, in a leaf: the element before an internal value is the last one
+	// of a leaf
+	iterator	insert_before(iterator pos, const value_type &value)
+	{
+		if (!this->root)
+			return this->insert_first(value);
+		if (!pos.node->leaf)
+		{
+			--pos;
+			pos.position++;
+		}
+		return this->insert_leaf(pos.node, pos.position, value);
+	}
+
+	iterator	insert_leaf(node_type *n, int i, const value_type &value)
+	{
+		if (n->count == SLOTS)
+		{
+			// value may be one of the elements moved by the split
+			value_type tmp(value);
+			this->split(n, i);
+			return this->insert_slot(n, i, tmp);
+		}
+		return this->insert_slot(n, i, value);
+	}
+
+	iterator	insert_slot(node_type *n, int i, const value_type &value)
+	{
+		const value_type *src = &value;
+		if (src >= &n->value(i) && src < &n->value(n->count))
+			src++;
+		this->relocate(&n->value(i + 1), &n->value(i), n->count - i, trivial_values());
+		this->allocator.construct(&n->value(i), *src);
+		n->count++;
+		this->_size++;
+#ifdef DEBUG_BTREE_HPP
+		this->btree_test();
+#endif
+		return iterator(n, i);
+	}
+
+	// split the full node n in two, the value between the halves goes up to the parent (split first if it is full
+	// too). n and i are updated to the node and index where the value to insert at i goes. the split is biased toward
+	// the side of i so that sequential insertions leave full nodes behind them
+	void	split(node_type *&n, int &i)
+	{
+		if (!n->parent)
+		{
+			this->root = this->new_node(false);
+			set_child(this->root, 0, n);
+		}
+		else if (n->parent->count == SLOTS)
+		{
+			node_type *up = n->parent;
+			int up_i = n->position;
+			this->split(up, up_i);
+		}
+		int right_count = n->count / 2;
+		if (i == 0)
+			right_count = n->count - 1;
+		else if (i == SLOTS)
+			right_count = 0;
+		int left_count = n->count - right_count - 1;
+		node_type *right = this->new_node(n->leaf);
+		this->relocate(&right->value(0), &n->value(left_count + 1), right_count, trivial_values());
+		if (!n->leaf)
+			move_children(right, 0, n, left_count + 1, right_count + 1);
+		right->count = right_count;
+		node_type *up = n->parent;
+		int k = n->position;
+		this->relocate(&up->value(k + 1), &up->value(k), up->count - k, trivial_values());
+		move_children(up, k + 2, up, k + 1, up->count - k);
+		this->relocate(&up->value(k), &n->value(left_count), 1, trivial_values());
+		set_child(up, k + 1, right);
+		up->count++;
+		n->count = left_count;
+		if (this->rightmost == n)
+			this->rightmost = right;
+		if (i > left_count)
+		{
+			n = right;
+			i -= left_count + 1;
+		}
+	}
+
+	// erase the element at it and return the position of the one following it
+	iterator	erase_at(iterator it)
+	{
+		node_type *n = it.node;
+		int i = it.position;
+		bool internal = !n->leaf;
+		this->allocator.destroy(&n->value(i));
+		if (internal)
+		{
+			// the value is replaced with the one before it, the last one of a leaf, the position past the end of
+			// that leaf then leads to it
+			node_type *leaf = child(n, i);
+			while (!leaf->leaf)
+				leaf = child(leaf, leaf->count);
+			this->relocate(&n->value(i), &leaf->value(leaf->count - 1), 1, trivial_values());
+			leaf->count--;
+			n = leaf;
+			i = leaf->count;
+		}
+		else
+		{
+			this->relocate(&n->value(i), &n->value(i + 1), n->count - i - 1, trivial_values());
+			n->count--;
+		}
+		this->_size--;
+		iterator next(n, i);
+		this->rebalance(n, next);
+#ifdef DEBUG_BTREE_HPP
+		this->btree_test();
+#endif
+		if (!this->root)
+			return this->end();
+		if (next.position == next.node->count)
+			climb_right(next.node, next.position);
+		if (internal)
+			++next;
+		return next;
+	}
+
+	// refill n, short of values after an erasure, from a sibling with values to spare or merge it with one, then go
+	// on with the parent if it is short too. it is kept on the same element
+	void	rebalance(node_type *n, iterator &it)
+	{
+		while (n != this->root && n->count < MIN_SLOTS)
+		{
+			node_type *up = n->parent;
+			int k = n->position;
+			node_type *left = k > 0 ? child(up, k - 1) : NULL;
+			node_type *right = k < up->count ? child(up, k + 1) : NULL;
+			if (left && left->count > MIN_SLOTS)
+			{
+				if (it.node == n)
+					it.position++;
+				return this->rotate_right(left, n);
+			}
+			if (right && right->count > MIN_SLOTS)
+				return this->rotate_left(n, right);
+			if (left)
+			{
+				if (it.node == n)
+				{
+					it.node = left;
+					it.position += left->count + 1;
+				}
+				this->merge(left, n);
+			}
+			else
+				this->merge(n, right);
+			n = up;
+		}
+		if (n != this->root || n->count)
+			return;
+		if (n->leaf)
+		{
+			this->root = NULL;
+			this->leftmost = NULL;
+			this->rightmost = NULL;
+		}
+		else
+		{
+			this->root = child(n, 0);
+			this->root->parent = NULL;
+			this->root->position = 0;
+		}
+		this->free_node(n);
+	}
+
+	// the last value of left goes up to the parent and the value between them down to the front of n
+	void	rotate_right(node_type *left, node_type *n)
+	{
+		node_type *up = n->parent;
+		int k = n->position - 1;
+		this->relocate(&n->value(1), &n->value(0), n->count, trivial_values());
+		this->relocate(&n->value(0), &up->value(k), 1, trivial_values());
+		this->relocate(&up->value(k), &left->value(left->count - 1), 1, trivial_values());
+		if (!n->leaf)
+		{
+			move_children(n, 1, n, 0, n->count + 1);
+			set_child(n, 0, child(left, left->count));
+		}
+		left->count--;
+		n->count++;
+	}
+
+	// the first value of right goes up to the parent and the value between them down to the back of n
+	void	rotate_left(node_type *n, node_type *right)
+	{
+		node_type *up = n->parent;
+		int k = n->position;
+		this->relocate(&n->value(n->count), &up->value(k), 1, trivial_values());
+		this->relocate(&up->value(k), &right->value(0), 1, trivial_values());
+		this->relocate(&right->value(0), &right->value(1), right->count - 1, trivial_values());
+		if (!n->leaf)
+		{
+			set_child(n, n->count + 1, child(right, 0));
+			move_children(right, 0, right, 1, right->count);
+		}
+		n->count++;
+		right->count--;
+	}
+
+	// append the value between them and the content of right to left, right is freed
+	void	merge(node_type *left, node_type *right)
+	{
+		node_type *up = left->parent;
+		int k = left->position;
+		this->relocate(&left->value(left->count), &up->value(k), 1, trivial_values());
+		this->relocate(&left->value(left->count + 1), &right->value(0), right->count, trivial_values());
+		if (!left->leaf)
+			move_children(left, left->count + 1, right, 0, right->count + 1);
+		left->count += right->count + 1;
+		this->relocate(&up->value(k), &up->value(k + 1), up->count - k - 1, trivial_values());
+		move_children(up, k + 1, up, k + 2, up->count - k - 1);
+		up->count--;
+		if (this->rightmost == right)
+			this->rightmost = left;
+		this->free_node(right);
+	}
+
+	// move n values to the uninitialized slots at dst, the slots at src are left uninitialized. the ranges may overlap
+	void	relocate(value_type *dst, value_type *src, int n, ft::true_type)
+	{
+		if (n > 0)
+			__builtin_memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(value_type));
+	}
+
+	void	relocate(value_type *dst, value_type *src, int n, ft::false_type)
+	{
+		if (dst < src)
+		{
+			for (int i = 0; i < n; i++)
+			{
+				this->allocator.construct(dst + i, ft::move_if_noexcept(src[i]));
+				this->allocator.destroy(src + i);
+			}
+		}
+		else
+		{
+			for (int i = n - 1; i >= 0; i--)
+			{
+				this->allocator.construct(dst + i, ft::move_if_noexcept(src[i]));
+				this->allocator.destroy(src + i);
+			}
+		}
+	}
+
+	// move n children of src from index si to index di of dst, the ranges may overlap
+	static void	move_children(node_type *dst, int di, node_type *src, int si, int n)
+	{
+		if (dst != src || di < si)
+			for (int i = 0; i < n; i++)
+				set_child(dst, di + i, child(src, si + i));
+		else
+			for (int i = n - 1; i >= 0; i--)
+				set_child(dst, di + i, child(src, si + i));
+	}
+
+	node_type	*new_node(bool leaf)
+	{
+		node_type *n;
+		if (leaf)
+			n = this->leaf_allocator.allocate(1);
+		else
+			n = this->internal_allocator.allocate(1);
+		n->parent = NULL;
+		n->position = 0;
+		n->count = 0;
+		n->leaf = leaf;
+		return n;
+	}
+
+	void	free_node(node_type *n)
+	{
+		if (n->leaf)
+			this->leaf_allocator.deallocate(n, 1);
+		else
+			this->internal_allocator.deallocate(static_cast<internal_node_type *>(n), 1);
+	}
+
+	node_type	*copy_node(const node_type *other, node_type *parent)
+	{
+		node_type *n = this->new_node(other->leaf);
+		n->parent = parent;
+		n->position = other->position;
+		for (; n->count < other->count; n->count++)
+			this->allocator.construct(&n->value(n->count), other->value(n->count));
+		if (!other->leaf)
+			for (int i = 0; i <= other->count; i++)
+				child(n, i) = this->copy_node(child(other, i), n);
+		return n;
+	}
+
+	void	destroy_tree(node_type *n)
+	{
+		if (!n->leaf)
+			for (int i = 0; i <= n->count; i++)
+				this->destroy_tree(child(n, i));
+		this->destroy_values(n, typename ft::is_trivially_destructible<value_type>::type());
+		this->free_node(n);
+	}
+
+	void	destroy_values(node_type *, ft::true_type) {}
+
+	void	destroy_values(node_type *n, ft::false_type)
+	{
+		for (int i = 0; i < n->count; i++)
+			this->allocator.destroy(&n->value(i));
+	}
+public:
+#ifdef DEBUG_BTREE_HPP
+	bool	btree_test() const
+	{
+		size_type count = 0;
+		int depth = -1;
+		if (this->root && (this->root->parent || !this->node_test(this->root, 0, depth, count)))
+		{
+			std::cout << "!!!!!!! NOT A B-TREE !!!!!!!!" << std::endl;
+			return false;
+		}
+		if (count != this->_size)
+		{
+			std::cout << "wrong size" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool	node_test(const node_type *n, int level, int &depth, size_type &count) const
+	{
+		count += n->count;
+		if (n->count > SLOTS || (n != this->root && !n->count))
+			return false;
+		for (int i = 1; i < n->count; i++)
+			if (this->_value_comp(n->value(i), n->value(i - 1)) || (!multi && !this->_value_comp(n->value(i - 1), n->value(i))))
+				return false;
+		if (n->leaf)
+		{
+			if (depth == -1)
+				depth = level;
+			return depth == level;
+		}
+		for (int i = 0; i <= n->count; i++)
+		{
+			const node_type *c = child(n, i);
+			if (c->parent != n || c->position != i || !this->node_test(c, level + 1, depth, count))
+				return false;
+			if (i < n->count && this->_value_comp(n->value(i), c->value(c->count - 1)))
+				return false;
+			if (i > 0 && this->_value_comp(c->value(0), n->value(i - 1)))
+				return false;
+		}
+		return true;
+	}
+#endif
+};
+
+template<
+		class	Key,
+		class	Value,
+		class	Compare,
+		class	Allocator,
+		bool	multi,
+		class	KeyOfValue,
+		size_t	NodeSize
+>
+void swap( btree<Key, Value, Compare, Allocator, multi, KeyOfValue, NodeSize>& lhs,
+		   btree<Key, Value, Compare, Allocator, multi, KeyOfValue, NodeSize>& rhs )
+{
+	lhs.swap(rhs);
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef FT_CONTAINERS_BTREE_MAP_HPP
+#define FT_CONTAINERS_BTREE_MAP_HPP
+#include "utility.hpp"
+#include <memory>
+#include "btree.hpp"
+
+namespace ft {
+
+	// map on a b-tree, NodeSize is the size in bytes of the nodes
+	template<
+			class Key,
+			class T,
+			class Compare = ft::less <Key>,
+			class Allocator = std::allocator <ft::pair<const Key, T> >,
+			size_t NodeSize = 256
+	>
+	class btree_map : public btree<Key, ft::pair<const Key, T>, Compare, Allocator, false, get_first, NodeSize> {
+	private:
+		typedef btree<Key, ft::pair<const Key, T>, Compare, Allocator, false, get_first, NodeSize> tree_type;
+	public:
+		typedef T									mapped_type;
+
+		btree_map() : tree_type() {}
+
+		explicit btree_map(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		btree_map(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+
+		T& operator[]( const Key& key )
+		{
+			ft::pair<typename tree_type::iterator, bool> res = this->insert(ft::make_pair(key, mapped_type()));
+			return res.first->second;
+		}
+	};
+
+	template<
+			class Key,
+			class T,
+			class Compare = ft::less <Key>,
+			class Allocator = std::allocator <ft::pair<const Key, T> >,
+			size_t NodeSize = 256
+	>
+	class btree_multimap : public btree<Key, ft::pair<const Key, T>, Compare, Allocator, true, get_first, NodeSize> {
+	private:
+		typedef btree<Key, ft::pair<const Key, T>, Compare, Allocator, true, get_first, NodeSize> tree_type;
+	public:
+		typedef T									mapped_type;
+
+		btree_multimap() : tree_type() {}
+
+		explicit btree_multimap(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		btree_multimap(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+	};
+
+	template<
+			class Key,
+			class T,
+			class Compare,
+			class Allocator,
+			size_t NodeSize
+	>
+	void	swap(ft::btree_map<Key, T, Compare, Allocator, NodeSize> &lhs, ft::btree_map<Key, T, Compare, Allocator, NodeSize> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+
+	template<
+			class Key,
+			class T,
+			class Compare,
+			class Allocator,
+			size_t NodeSize
+	>
+	void	swap(ft::btree_multimap<Key, T, Compare, Allocator, NodeSize> &lhs, ft::btree_multimap<Key, T, Compare, Allocator, NodeSize> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef FT_CONTAINERS_BTREE_SET_HPP
+#define FT_CONTAINERS_BTREE_SET_HPP
+#include "utility.hpp"
+#include <memory>
+#include "btree.hpp"
+
+namespace ft {
+
+	// set on a b-tree, NodeSize is the size in bytes of the nodes
+	template<
+			class Key,
+			class Compare = ft::less<Key>,
+			class Allocator = std::allocator<Key>,
+			size_t NodeSize = 256
+	>
+	class btree_set : public btree<Key, Key, Compare, Allocator, false, ft::identity, NodeSize> {
+	private:
+		typedef btree<Key, Key, Compare, Allocator, false, ft::identity, NodeSize> tree_type;
+	public:
+		btree_set() : tree_type() {}
+
+		explicit btree_set(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		btree_set(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+	};
+
+	template<
+			class Key,
+			class Compare = ft::less<Key>,
+			class Allocator = std::allocator<Key>,
+			size_t NodeSize = 256
+	>
+	class btree_multiset : public btree<Key, Key, Compare, Allocator, true, ft::identity, NodeSize> {
+	private:
+		typedef btree<Key, Key, Compare, Allocator, true, ft::identity, NodeSize> tree_type;
+	public:
+		btree_multiset() : tree_type() {}
+
+		explicit btree_multiset(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		btree_multiset(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+	};
+
+	template<
+			class Key,
+			class Compare,
+			class Allocator,
+			size_t NodeSize
+	>
+	void	swap(ft::btree_set<Key, Compare, Allocator, NodeSize> &lhs, ft::btree_set<Key, Compare, Allocator, NodeSize> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+
+	template<
+			class Key,
+			class Compare,
+			class Allocator,
+			size_t NodeSize
+	>
+	void	swap(ft::btree_multiset<Key, Compare, Allocator, NodeSize> &lhs, ft::btree_multiset<Key, Compare, Allocator, NodeSize> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+}
+
+#endif
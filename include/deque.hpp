@@ -11,9 +11,13 @@
 #include <cstddef>
 
 namespace ft {
+	// elements are stored in blocks of about BlockBytes bytes (at least one element per block),
+	// up to SpareBlocks freed blocks are kept to be reused instead of being deallocated
 	template<
 			class T,
-			class Allocator = std::allocator<T>
+			class Allocator = std::allocator<T>,
+			size_t BlockBytes = 512,
+			size_t SpareBlocks = 2
 	>
 	class deque {
 	public:
@@ -25,6 +29,7 @@ namespace ft {
 		typedef const value_type					&const_reference;
 		typedef typename Allocator::pointer 		pointer;
 		typedef typename Allocator::const_pointer	const_pointer;
+		static const size_type						node_size = sizeof(T) < BlockBytes ? BlockBytes / sizeof(T) : 1;
 	private:
 
 		template<typename pointed_type>
@@ -36,15 +41,14 @@ namespace ft {
 			typedef ft::random_access_iterator_tag	iterator_category;
 
 			pointer		*node;
-			size_type	node_size;
 			size_type	current;
 
-			iterator_t() : node(NULL), node_size(0), current(0) {}
+			iterator_t() : node(NULL), current(0) {}
 
-			explicit iterator_t(pointer *n, size_type n_s, size_type c) : node(n), node_size(n_s), current(c) {}
+			explicit iterator_t(pointer *n, size_type c) : node(n), current(c) {}
 
 			template<typename U>
-			iterator_t(iterator_t<U> const &other) : node((pointer *)other.node), node_size(other.node_size), current(other.current) {}
+			iterator_t(iterator_t<U> const &other) : node((pointer *)other.node), current(other.current) {}
 
 			iterator_t &operator++() {
 				++current;
@@ -93,18 +97,16 @@ namespace ft {
 
 			iterator_t &operator+=(difference_type n)
 			{
-				this->node += n / (difference_type)this->node_size;
-				n %= (difference_type)this->node_size;
+				this->node += n / (difference_type)node_size;
+				n %= (difference_type)node_size;
 
-				if ((difference_type)this->current + n >= (difference_type)this->node_size)
+				if ((difference_type)this->current + n >= (difference_type)node_size)
 					this->node++;
 				else if ((difference_type)this->current + n < 0)
 					this->node--;
 
-				this->current += n + this->node_size;
-				this->current %= (difference_type)this->node_size;
-				if (this->current < 0)
-					this->current += this->node_size;
+				this->current += n + node_size;
+				this->current %= (difference_type)node_size;
 				return *this;
 			}
 
@@ -125,7 +127,7 @@ namespace ft {
 		public:
 		template<typename LT, typename RT>
 		friend difference_type operator-(iterator_t<LT> lhs, iterator_t<RT> rhs) {
-			return ((typename iterator_t<LT>::pointer *)lhs.node - (typename iterator_t<LT>::pointer *)rhs.node) * lhs.node_size + (lhs.current - rhs.current);
+			return ((typename iterator_t<LT>::pointer *)lhs.node - (typename iterator_t<LT>::pointer *)rhs.node) * (difference_type)node_size + (lhs.current - rhs.current);
 		}
 		template<typename LT, typename RT>
 		friend bool operator==(iterator_t<LT> l, iterator_t<RT> r) { return l.node == r.node && l.current == r.current; }
@@ -165,31 +167,32 @@ namespace ft {
 		size_type													_size;
 		allocator_type												allocator;
 		typename allocator_type::template rebind<pointer>::other	map_allocator;
-		static const size_type										node_size = 10;
+		pointer														spare[SpareBlocks ? SpareBlocks : 1];
+		size_type													spare_count;
 	public:
-		deque() : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(), map_allocator() {
+		deque() : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(), map_allocator(), spare_count(0) {
 			this->init();
 		}
 
-		explicit deque( const Allocator& alloc ) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(alloc), map_allocator(alloc) {
+		explicit deque( const Allocator& alloc ) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(alloc), map_allocator(alloc), spare_count(0) {
 			this->init();
 		}
 
 		explicit deque( size_type count,
 					   const T& value = T(),
-					   const Allocator& alloc = Allocator()) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(alloc), map_allocator(alloc) {
+					   const Allocator& alloc = Allocator()) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(alloc), map_allocator(alloc), spare_count(0) {
 			this->init();
 			this->insert(this->end(), count, value);
 		}
 
 		template< class InputIt >
-		deque( InputIt f, InputIt l, const Allocator& alloc = Allocator()) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(alloc), map_allocator(alloc)
+		deque( InputIt f, InputIt l, const Allocator& alloc = Allocator()) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(alloc), map_allocator(alloc), spare_count(0)
 		{
 			this->init();
 			this->insert(this->end(), f, l);
 		}
 
-		deque( const deque& other ) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(other.allocator), map_allocator(other.allocator) {
+		deque( const deque& other ) : map(NULL), first(), last(), map_capacity(0), _size(0), allocator(other.allocator), map_allocator(other.allocator), spare_count(0) {
 			this->init();
 			this->insert(this->end(), other.begin(), other.end());
 		}
@@ -281,7 +284,9 @@ namespace ft {
 	private:
 		iterator insert( const_iterator pos, size_type count, const T& value, ft::true_type)
 		{
-			return this->insert(pos, generator_it<const T&>(value), generator_it<const T&>(count, value), ft::false_type());
+			// value may be an element of this deque that the insertion shifts
+			T tmp(value);
+			return this->insert(pos, generator_it<const T&>(tmp), generator_it<const T&>(count, tmp), ft::false_type());
 		}
 
 		template< class It >
@@ -289,12 +294,12 @@ namespace ft {
 		{
 			size_t count = ft::distance(f, l);
 			if (count == 0)
-				return iterator((pointer *)pos.node, pos.node_size, pos.current);
+				return iterator((pointer *)pos.node, pos.current);
 			difference_type offset = pos - this->first;
 			if ((size_type)(pos - this->begin()) > this->size() / 2)
 			{
-				if (count > (last.node_size - last.current - 1))
-					this->add_nodes_back((count - (last.node_size - last.current - 1)) / node_size + ((count - (last.node_size - last.current - 1)) % node_size != 0));
+				if (count > (node_size - last.current - 1))
+					this->add_nodes_back((count - (node_size - last.current - 1)) / node_size + ((count - (node_size - last.current - 1)) % node_size != 0));
 				pos = this->first + offset;
 				internal_insert(iterator(pos), f, l, this->end(), count);
 				this->last += count;
@@ -373,7 +378,7 @@ namespace ft {
 				for (it1 = f, it2 = l; it2 < this->end(); it1++, it2++)
 					*it1 = *it2;
 				if (it2.node > it1.node) {
-					this->destroy(it1.operator->(), (difference_type) it1.node_size - (difference_type) it1.current);
+					this->destroy(it1.operator->(), (difference_type) node_size - (difference_type) it1.current);
 					this->erase_node(it1.node + 1, this->last.node + 1);
 				} else
 					this->destroy(it1.operator->(), it2 - it1);
@@ -395,13 +400,42 @@ namespace ft {
 			return this->begin() + offset;
 		}
 
-		void push_back( const T& value ) {this->insert(const_iterator(this->end()), value);}
+		void push_back( const T& value )
+		{
+			// last always points into an allocated block
+			if (this->last.current == node_size - 1)
+				this->add_nodes_back(1);
+			this->allocator.construct(this->last.operator->(), value);
+			++this->_size;
+			++this->last;
+		}
 
-		void pop_back() {this->erase(this->end() - 1);}
+		void pop_back()
+		{
+			--this->last;
+			this->destroy(this->last.operator->(), 1);
+			if (this->last.current == node_size - 1)
+				this->release_node(this->last.node + 1);
+		}
 
-		void push_front( const T& value ) {this->insert(const_iterator(this->begin()), value);}
+		void push_front( const T& value )
+		{
+			if (this->first.current == 0)
+				this->add_nodes_front(1);
+			iterator it = this->first;
+			--it;
+			this->allocator.construct(it.operator->(), value);
+			++this->_size;
+			this->first = it;
+		}
 
-		void pop_front() {this->erase(this->begin());}
+		void pop_front()
+		{
+			this->destroy(this->first.operator->(), 1);
+			++this->first;
+			if (this->first.current == 0)
+				this->release_node(this->first.node - 1);
+		}
 
 		void resize( size_type count, T value = T() )
 		{
@@ -420,11 +454,16 @@ namespace ft {
 			ft::swap(this->_size, other._size);
 			ft::swap(this->allocator, other.allocator);
 			ft::swap(this->map_capacity, other.map_capacity);
+			for (size_type i = 0; i < SpareBlocks; i++)
+				ft::swap(this->spare[i], other.spare[i]);
+			ft::swap(this->spare_count, other.spare_count);
 		}
 
 	private:
 		void	init()
 		{
+			for (size_type i = 0; i < SpareBlocks; i++)
+				this->spare[i] = NULL;
 			this->reserve_map(1);
 		}
 		void	reserve_map(size_type new_cap)
@@ -438,55 +477,50 @@ namespace ft {
 			}
 			if (this->map)
 			{
-				for (size_t i = 0; i < this->map_capacity; i++)
-				{
-					if (this->first.node == this->map + i)
-						this->first.node = new_ptr + ((new_cap - this->map_capacity) / 2) + i;
-					if (this->last.node == this->map + i)
-						this->last.node = new_ptr + ((new_cap - this->map_capacity) / 2) + i;
-					new_ptr[(new_cap - this->map_capacity) / 2 + i] =
-							this->map[i];
-				}
-				for (size_t i = 0; i < this->map_capacity; i++)
-					this->map_allocator.destroy(this->map + i);
-				this->map_allocator.deallocate(this->map, 1);
+				// only the blocks in use are copied, to the middle of the new map
+				size_type used = this->last.node - this->first.node + 1;
+				pointer *start = new_ptr + (new_cap - used) / 2;
+				for (size_type i = 0; i < used; i++)
+					start[i] = this->first.node[i];
+				this->last.node = start + (used - 1);
+				this->first.node = start;
+				this->free_map();
 			}
 			else
 			{
-				this->first = iterator(new_ptr + new_cap / 2, node_size, node_size / 2);
+				this->first = iterator(new_ptr + new_cap / 2, node_size / 2);
 				this->last = this->first;
-				*(this->first.node) = this->allocator.allocate(node_size);
+				*(this->first.node) = this->new_node();
 			}
 			this->map_capacity = new_cap;
 			this->map = new_ptr;
 		}
+		// make room for count blocks before the first one or after the last one, the blocks are
+		// moved back to the middle of the map, which is doubled first if it is more than half full
+		void	recenter_map(size_type count, bool front)
+		{
+			size_type used = this->last.node - this->first.node + 1;
+			if ((used + count) * 2 > this->map_capacity)
+				this->reserve_map(ft::max(this->map_capacity * 2, (used + count) * 2));
+			pointer *start = this->map + (this->map_capacity - used - count) / 2 + (front ? count : 0);
+			this->move_nodes(start, this->first.node, used);
+		}
 		void	add_nodes_back(difference_type count)
 		{
 			if (this->map + this->map_capacity - (this->last.node + 1) < count)
-				this->reserve_map(this->map_capacity + count * 2);
+				this->recenter_map(count, false);
 
-			difference_type last_node = this->last.node - this->map;
-			while (this->map[last_node]) {
-				last_node++;
-			}
-			for (difference_type i = 0; i < count; i++)
-			{
-				this->map[last_node + i] = this->allocator.allocate(this->node_size);
-			}
+			// the blocks in use are exactly [first.node, last.node]
+			for (difference_type i = 1; i <= count; i++)
+				this->last.node[i] = this->new_node();
 		}
 		void	add_nodes_front(difference_type count)
 		{
- 			if (this->first.node - this->map < count)
-				this->reserve_map(this->map_capacity + count * 2);
+			if (this->first.node - this->map < count)
+				this->recenter_map(count, true);
 
-			difference_type first_node = this->first.node - this->map;
-			while (this->map[first_node]) {
-				first_node--;
-			}
-			for (difference_type i = 0; i < count; i++)
-			{
-				this->map[first_node - i] = this->allocator.allocate(this->node_size);
-			}
+			for (difference_type i = 1; i <= count; i++)
+				this->first.node[-i] = this->new_node();
 		}
 		void	free_map()
 		{
@@ -511,10 +545,25 @@ namespace ft {
 			if (this->last.node == n)
 				this->destroy(*n, this->last.current);
 			else if (this->first.node == n)
-				this->destroy(*n + this->first.current, this->first.node_size - this->first.current);
+				this->destroy(*n + this->first.current, node_size - this->first.current);
 			else
 				this->destroy(*n, node_size);
-			this->allocator.deallocate(*n, node_size);
+			this->release_node(n);
+		}
+		// take a block from the spare ones if there is one
+		pointer	new_node()
+		{
+			if (this->spare_count)
+				return this->spare[--this->spare_count];
+			return this->allocator.allocate(node_size);
+		}
+		// give back the (empty) block n, it is kept as a spare one if there is room for it
+		void	release_node(pointer *n)
+		{
+			if (this->spare_count < SpareBlocks)
+				this->spare[this->spare_count++] = *n;
+			else
+				this->allocator.deallocate(*n, node_size);
 			*n = NULL;
 		}
 		void	erase_node(pointer *f, pointer *l)
@@ -526,25 +575,22 @@ namespace ft {
 			else
 				move_nodes(this->first.node + (l - f), this->first.node, f - this->first.node);
 		}
+		// move the n block pointers at src to dst, the slots left behind are cleared
 		void	move_nodes(pointer *dst, pointer *src, size_type n)
 		{
+			if (this->first.node >= src && this->first.node < src + n)
+				this->first.node += dst - src;
+			if (this->last.node >= src && this->last.node < src + n)
+				this->last.node += dst - src;
 			if (dst < src)
 				for (size_type i = 0; i < n; i++)
 				{
-					if (this->last.node == src + i)
-						this->last.node = dst + i;
-					if (this->first.node == src + i)
-						this->first.node = dst + i;
 					dst[i] = src[i];
 					src[i] = NULL;
 				}
 			else if (dst > src)
 				for (size_type i = n; i > 0; i--)
 				{
-					if (this->last.node == src + i - 1)
-						this->last.node = dst + i - 1;
-					if (this->first.node == src + i - 1)
-						this->first.node = dst + i - 1;
 					dst[i - 1] = src[i - 1];
 					src[i - 1] = NULL;
 				}
@@ -552,39 +598,40 @@ namespace ft {
 		void free() {
 			this->clear();
 			this->allocator.deallocate(*this->last.node, this->node_size);
+			while (this->spare_count)
+				this->allocator.deallocate(this->spare[--this->spare_count], node_size);
 			this->free_map();
 		}
 	};
 
-	template <class T, class Allocator>
-	bool operator==(const deque<T, Allocator> &lhs, const deque<T, Allocator> &rhs) {
-		return ((lhs.size() == rhs.size()) && ft::equal<typename deque<T, Allocator>::const_iterator, typename deque<T, Allocator>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin()));
+	template <class T, class Allocator, size_t BlockBytes, size_t SpareBlocks>
+	bool operator==(const deque<T, Allocator, BlockBytes, SpareBlocks> &lhs, const deque<T, Allocator, BlockBytes, SpareBlocks> &rhs) {
+		return ((lhs.size() == rhs.size()) && ft::equal<typename deque<T, Allocator, BlockBytes, SpareBlocks>::const_iterator, typename deque<T, Allocator, BlockBytes, SpareBlocks>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin()));
 	}
-	template <class T, class Allocator>
- 	bool operator!=(const deque<T, Allocator> &lhs, const deque<T, Allocator> &rhs) {
+	template <class T, class Allocator, size_t BlockBytes, size_t SpareBlocks>
+ 	bool operator!=(const deque<T, Allocator, BlockBytes, SpareBlocks> &lhs, const deque<T, Allocator, BlockBytes, SpareBlocks> &rhs) {
 		return (!(lhs == rhs));
 	}
-	template <class T, class Allocator>
- 	bool operator<(const deque<T, Allocator> &lhs, const deque<T, Allocator> &rhs) {
-		return (ft::lexicographical_compare<typename deque<T, Allocator>::const_iterator, typename deque<T, Allocator>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	template <class T, class Allocator, size_t BlockBytes, size_t SpareBlocks>
+ 	bool operator<(const deque<T, Allocator, BlockBytes, SpareBlocks> &lhs, const deque<T, Allocator, BlockBytes, SpareBlocks> &rhs) {
+		return (ft::lexicographical_compare<typename deque<T, Allocator, BlockBytes, SpareBlocks>::const_iterator, typename deque<T, Allocator, BlockBytes, SpareBlocks>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
-	template <class T, class Allocator>
-	bool operator<=(const deque<T, Allocator> &lhs, const deque<T, Allocator> &rhs) {
+	template <class T, class Allocator, size_t BlockBytes, size_t SpareBlocks>
+	bool operator<=(const deque<T, Allocator, BlockBytes, SpareBlocks> &lhs, const deque<T, Allocator, BlockBytes, SpareBlocks> &rhs) {
 		return (!(rhs < lhs));
 	}
-	template <class T, class Allocator>
-	bool operator>(const deque<T, Allocator> &lhs, const deque<T, Allocator> &rhs) {
+	template <class T, class Allocator, size_t BlockBytes, size_t SpareBlocks>
+	bool operator>(const deque<T, Allocator, BlockBytes, SpareBlocks> &lhs, const deque<T, Allocator, BlockBytes, SpareBlocks> &rhs) {
 		return (rhs < lhs);
 	}
-	template <class T, class Allocator>
-	bool operator>=(const deque<T, Allocator> &lhs, const deque<T, Allocator> &rhs) {
+	template <class T, class Allocator, size_t BlockBytes, size_t SpareBlocks>
+	bool operator>=(const deque<T, Allocator, BlockBytes, SpareBlocks> &lhs, const deque<T, Allocator, BlockBytes, SpareBlocks> &rhs) {
 		return (!(lhs < rhs));
 	}
 
-	template< class T, class Alloc >
-	void swap( ft::deque<T, Alloc>& lhs,//			std::cout  << last_node << std::
-
-			   ft::deque<T, Alloc>& rhs)
+	template< class T, class Alloc, size_t BlockBytes, size_t SpareBlocks >
+	void swap( ft::deque<T, Alloc, BlockBytes, SpareBlocks>& lhs,
+			   ft::deque<T, Alloc, BlockBytes, SpareBlocks>& rhs)
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,77 @@
+#ifndef FT_CONTAINERS_FLAT_HASH_MAP_HPP
+# define FT_CONTAINERS_FLAT_HASH_MAP_HPP
+# include "flat_hash_table.hpp"
+
+namespace ft {
+	// unordered_map storing its elements in an open addressing table instead of one node per element
+	template<
+			class Key,
+			class T,
+			class Hash = ft::hash<Key>,
+			class KeyEqual = ft::equal_to<Key>,
+			class Allocator = std::allocator< ft::pair<const Key, T> >
+	> class flat_hash_map : public flat_hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, get_first>
+	{
+	private:
+		typedef flat_hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, get_first> hash_table_type;
+	public:
+		typedef T									mapped_type;
+
+		flat_hash_map() : hash_table_type() {}
+
+		explicit flat_hash_map( typename hash_table_type::size_type bucket_count,
+								const Hash& hash = Hash(),
+								const typename hash_table_type::key_equal& equal = typename hash_table_type::key_equal(),
+								const Allocator& alloc = Allocator() ) : hash_table_type(bucket_count, hash, equal, alloc)
+		{}
+
+		explicit flat_hash_map( const Allocator& alloc ) : hash_table_type(alloc) {}
+
+		template< class InputIt >
+		flat_hash_map( InputIt first, InputIt last,
+					   typename hash_table_type::size_type bucket_count = 0,
+					   const Hash& hash = Hash(),
+					   const typename hash_table_type::key_equal& equal = typename hash_table_type::key_equal(),
+					   const Allocator& alloc = Allocator() ) : hash_table_type(first, last, bucket_count, hash, equal, alloc) {}
+
+		flat_hash_map( const flat_hash_map& other, const Allocator& alloc ) : hash_table_type(other, alloc) {}
+
+		T& operator[]( const Key& key )
+		{
+			typename hash_table_type::iterator it = this->find(key);
+			if (it == this->end())
+				it = this->insert(ft::make_pair(key, mapped_type())).first;
+			return it->second;
+		}
+
+		T& at( const Key& key )
+		{
+			typename hash_table_type::iterator it = this->find(key);
+			if (it == this->end())
+				throw ft::out_of_range("key not found");
+			return it->second;
+		}
+
+		const T& at( const Key& key ) const
+		{
+			typename hash_table_type::const_iterator it = this->find(key);
+			if (it == this->end())
+				throw ft::out_of_range("key not found");
+			return it->second;
+		}
+	};
+
+	template<
+			class Key,
+			class T,
+			class Hash,
+			class KeyEqual,
+			class Allocator
+	>
+	void	swap(ft::flat_hash_map<Key, T, Hash, KeyEqual, Allocator> &lhs, ft::flat_hash_map<Key, T, Hash, KeyEqual, Allocator> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef FT_CONTAINERS_FLAT_HASH_SET_HPP
+# define FT_CONTAINERS_FLAT_HASH_SET_HPP
+# include "flat_hash_table.hpp"
+
+namespace ft {
+	// unordered_set storing its elements in an open addressing table instead of one node per element
+	template<
+			class Key,
+			class Hash = ft::hash<Key>,
+			class KeyEqual = ft::equal_to<Key>,
+			class Allocator = std::allocator<Key>
+	> class flat_hash_set : public flat_hash_table<Key, Key, Hash, KeyEqual, Allocator, ft::identity>
+	{
+	private:
+		typedef flat_hash_table<Key, Key, Hash, KeyEqual, Allocator, ft::identity> hash_table_type;
+	public:
+		flat_hash_set() : hash_table_type() {}
+
+		explicit flat_hash_set( typename hash_table_type::size_type bucket_count,
+								const Hash& hash = Hash(),
+								const typename hash_table_type::key_equal& equal = typename hash_table_type::key_equal(),
+								const Allocator& alloc = Allocator() ) : hash_table_type(bucket_count, hash, equal, alloc)
+		{}
+
+		explicit flat_hash_set( const Allocator& alloc ) : hash_table_type(alloc) {}
+
+		template< class InputIt >
+		flat_hash_set( InputIt first, InputIt last,
+					   typename hash_table_type::size_type bucket_count = 0,
+					   const Hash& hash = Hash(),
+					   const typename hash_table_type::key_equal& equal = typename hash_table_type::key_equal(),
+					   const Allocator& alloc = Allocator() ) : hash_table_type(first, last, bucket_count, hash, equal, alloc) {}
+
+		flat_hash_set( const flat_hash_set& other, const Allocator& alloc ) : hash_table_type(other, alloc) {}
+	};
+
+	template<
+			class Key,
+			class Hash,
+			class KeyEqual,
+			class Allocator
+	>
+	void	swap(ft::flat_hash_set<Key, Hash, KeyEqual, Allocator> &lhs, ft::flat_hash_set<Key, Hash, KeyEqual, Allocator> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+}
+
+#endif
@@ -0,0 +1,805 @@
+#ifndef FT_CONTAINERS_FLAT_HASH_TABLE_HPP
+# define FT_CONTAINERS_FLAT_HASH_TABLE_HPP
+#include "utility.hpp"
+#include "iterator.hpp"
+#include <memory>
+#include <cstddef>
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "type_traits.hpp"
+#include "stdexcept.hpp"
+#if defined(__AVX2__) && !defined(FT_FLAT_HASH_NO_SIMD)
+# include <immintrin.h>
+#elif defined(__SSE2__) && !defined(FT_FLAT_HASH_NO_SIMD)
+# include <emmintrin.h>
+#endif
+
+namespace ft {
+
+	// state of a slot kept in its control byte: a full slot stores the low 7 bits of the hash of its key (H2), so
+	// most of the slots whose key differs are rejected without looking at the key
+	enum e_flat_hash_ctrl {
+		FLAT_HASH_EMPTY = -128,
+		FLAT_HASH_DELETED = -2,
+		FLAT_HASH_SENTINEL = -1
+	};
+
+	// a group of control bytes probed at once: a byte matches when its bit is set in the mask returned, masks are
+	// walked from their lowest bit. the group is compared with one SIMD instruction when the target has them
+	// (FT_FLAT_HASH_NO_SIMD forces the portable version), otherwise 8 bytes are compared in a word
+
+	// 8 bytes in a word, the mask has the high bit of the matching bytes set
+	struct flat_hash_group_portable {
+		enum e_group {WIDTH = 8};
+		typedef unsigned long long	mask_type;
+
+		mask_type ctrl;
+
+		explicit flat_hash_group_portable(const signed char *p) : ctrl(0) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			__builtin_memcpy(&this->ctrl, p, sizeof(this->ctrl));
+#else
+			for (int i = 0; i < WIDTH; i++)
+				this->ctrl |= (mask_type)(unsigned char)p[i] << (i * 8);
+#endif
+		}
+
+		static mask_type lsbs() { return 0x0101010101010101ULL; }
+		static mask_type msbs() { return 0x8080808080808080ULL; }
+
+		// a byte of a key whose H2 differs may match when the byte before it matched, the keys are compared anyway
+		mask_type match(signed char h2) const {
+			mask_type x = this->ctrl ^ (lsbs() * (unsigned char)h2);
+			return (x - lsbs()) & ~x & msbs();
+		}
+
+		mask_type match_empty() const {
+			return this->ctrl & (~this->ctrl << 6) & msbs();
+		}
+
+		mask_type match_empty_or_deleted() const {
+			return this->ctrl & (~this->ctrl << 7) & msbs();
+		}
+
+		static int first(mask_type mask) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(mask) >> 3;
+#else
+			int i = 0;
+			while (!(mask & 0x80))
+			{
+				mask >>= 8;
+				i++;
+			}
+			return i;
+#endif
+		}
+
+		// bytes after the last one matching
+		static int after_last(mask_type mask) {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(mask) >> 3;
+#else
+			int i = 0;
+			while (!(mask & 0x8000000000000000ULL))
+			{
+				mask <<= 8;
+				i++;
+			}
+			return i;
+#endif
+		}
+
+		static mask_type next(mask_type mask) {
+			return mask & (mask - 1);
+		}
+	};
+
+#if defined(__SSE2__) && !defined(FT_FLAT_HASH_NO_SIMD)
+	// 16 bytes in an SSE2 register, one bit per byte in the mask
+	struct flat_hash_group_sse2 {
+		enum e_group {WIDTH = 16};
+		typedef unsigned int	mask_type;
+
+		__m128i ctrl;
+
+		explicit flat_hash_group_sse2(const signed char *p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))) {}
+
+		mask_type match(signed char h2) const {
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), this->ctrl));
+		}
+
+		mask_type match_empty() const {
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(FLAT_HASH_EMPTY), this->ctrl));
+		}
+
+		// empty and deleted are the only control bytes below the sentinel
+		mask_type match_empty_or_deleted() const {
+			return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(FLAT_HASH_SENTINEL), this->ctrl));
+		}
+
+		static int first(mask_type mask) {
+			return __builtin_ctz(mask);
+		}
+
+		static int after_last(mask_type mask) {
+			return __builtin_clz(mask) - 16;
+		}
+
+		static mask_type next(mask_type mask) {
+			return mask & (mask - 1);
+		}
+	};
+#endif
+
+#if defined(__AVX2__) && !defined(FT_FLAT_HASH_NO_SIMD)
+	// 32 bytes in an AVX2 register, one bit per byte in the mask
+	struct flat_hash_group_avx2 {
+		enum e_group {WIDTH = 32};
+		typedef unsigned int	mask_type;
+
+		__m256i ctrl;
+
+		explicit flat_hash_group_avx2(const signed char *p) : ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p))) {}
+
+		mask_type match(signed char h2) const {
+			return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), this->ctrl));
+		}
+
+		mask_type match_empty() const {
+			return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(FLAT_HASH_EMPTY), this->ctrl));
+		}
+
+		mask_type match_empty_or_deleted() const {
+			return _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(FLAT_HASH_SENTINEL), this->ctrl));
+		}
+
+		static int first(mask_type mask) {
+			return __builtin_ctz(mask);
+		}
+
+		static int after_last(mask_type mask) {
+			return __builtin_clz(mask);
+		}
+
+		static mask_type next(mask_type mask) {
+			return mask & (mask - 1);
+		}
+	};
+
+	typedef flat_hash_group_avx2		flat_hash_group;
+#elif defined(__SSE2__) && !defined(FT_FLAT_HASH_NO_SIMD)
+	typedef flat_hash_group_sse2		flat_hash_group;
+#else
+	typedef flat_hash_group_portable	flat_hash_group;
+#endif
+
+	// control bytes of the tables which have no slot yet, so that lookups need no special case (as wide as the
+	// widest group)
+	template<class T>
+	struct flat_hash_empty_group {
+		static const signed char ctrl[32];
+	};
+
+	template<class T>
+	const signed char flat_hash_empty_group<T>::ctrl[32] = {
+		FLAT_HASH_SENTINEL, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY,
+		FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY, FLAT_HASH_EMPTY
+	};
+
+// open addressing hash table (SwissTable layout): the values are stored in an array of slots next to an array of
+// control bytes, a lookup probes groups of control bytes and only compares the keys of the slots whose H2 matches.
+// the capacity is a power of two minus one, the control byte following the last slot is a sentinel stopping the
+// iterators and the first WIDTH - 1 control bytes are copied after it so that a group can be loaded at any slot.
+// inserting may move every element (iterators are invalidated by a rehash only), erasing leaves a tombstone
+// unless no probe can have gone past the slot. there are no buckets to walk: the bucket interface is limited to
+// bucket_count (the number of slots), the load factor and reserve/rehash
+template <
+		class	Key,
+		class	Value,
+		class	Hash = ft::hash<Key>,
+		class	KeyEqual = ft::equal_to<Key>,
+		class	Allocator = std::allocator <Key>,
+		class	KeyOfValue = ft::identity
+        >
+	class flat_hash_table {
+	public:
+		typedef Key									key_type;
+		typedef Value								value_type;
+		typedef size_t								size_type;
+		typedef ptrdiff_t							difference_type;
+		typedef Hash								hasher;
+		typedef KeyEqual							key_equal;
+		typedef Allocator							allocator_type;
+		typedef value_type&							reference;
+		typedef const value_type&					const_reference;
+		typedef typename Allocator::pointer			pointer;
+		typedef typename Allocator::const_pointer	const_pointer;
+
+	private:
+		typedef flat_hash_group															group_type;
+		typedef typename allocator_type::template rebind<value_type>::other				slot_allocator;
+		typedef typename allocator_type::template rebind<signed char>::other			ctrl_allocator;
+		enum e_width {WIDTH = group_type::WIDTH};
+
+		template<class K, class R>
+		struct if_transparent : public ft::enable_if<ft::is_transparent<Hash>::value && ft::is_transparent<KeyEqual>::value, R> {};
+
+		template<typename pointed_type>
+		struct iterator_t {
+			typedef ptrdiff_t					difference_type;
+			typedef pointed_type				value_type;
+			typedef pointed_type				*pointer;
+			typedef pointed_type				&reference;
+			typedef ft::forward_iterator_tag	iterator_category;
+
+			const signed char				*ctrl;
+			typename flat_hash_table::value_type	*slot;
+
+			iterator_t() : ctrl(NULL), slot(NULL) {}
+
+			iterator_t(const signed char *c, typename flat_hash_table::value_type *s) : ctrl(c), slot(s) {}
+
+			template <class T>
+			iterator_t(iterator_t<T> const &other) : ctrl(other.ctrl), slot(other.slot) {}
+
+			// stops on the next full slot or on the sentinel
+			iterator_t &operator++() {
+				do {
+					++this->ctrl;
+					++this->slot;
+				} while (*this->ctrl < FLAT_HASH_SENTINEL);
+				return *this;
+			}
+
+			iterator_t operator++(int) {
+				iterator_t ret = *this;
+				++*this;
+				return ret;
+			}
+
+			reference operator*() const {
+				return *this->slot;
+			}
+
+			pointer operator->() const {
+				return this->slot;
+			}
+		};
+	public:
+		template<typename LT, typename RT>
+		friend bool operator==(iterator_t<LT> l, iterator_t<RT> r) { return l.ctrl == r.ctrl; }
+
+		template<typename LT, typename RT>
+		friend bool operator!=(iterator_t<LT> l, iterator_t<RT> r) { return l.ctrl != r.ctrl; }
+
+		typedef iterator_t<value_type> iterator;
+		typedef iterator_t<const value_type> const_iterator;
+	private:
+		signed char		*_ctrl;
+		value_type		*_slots;
+		size_type		_capacity;
+		size_type		_size;
+		// elements which can still be inserted in an empty slot before a rehash
+		size_type		_growth_left;
+		slot_allocator	_slot_allocator;
+		hasher			_hasher;
+		key_equal		_key_equal;
+	public:
+		flat_hash_table() : _ctrl(empty_ctrl()), _slots(NULL), _capacity(0), _size(0), _growth_left(0) {}
+
+		explicit flat_hash_table( size_type bucket_count,
+								const Hash& hash = Hash(),
+								const key_equal& equal = key_equal(),
+								const Allocator& alloc = Allocator() ) : _ctrl(empty_ctrl()), _slots(NULL), _capacity(0), _size(0), _growth_left(0), _slot_allocator(alloc), _hasher(hash), _key_equal(equal)
+		{
+			this->rehash(bucket_count);
+		}
+
+		explicit flat_hash_table( const Allocator& alloc ) : _ctrl(empty_ctrl()), _slots(NULL), _capacity(0), _size(0), _growth_left(0), _slot_allocator(alloc) {}
+
+		template< class InputIt >
+		flat_hash_table( InputIt first, InputIt last,
+		size_type bucket_count = 0,
+		const Hash& hash = Hash(),
+		const key_equal& equal = key_equal(),
+		const Allocator& alloc = Allocator() ) : _ctrl(empty_ctrl()), _slots(NULL), _capacity(0), _size(0), _growth_left(0), _slot_allocator(alloc), _hasher(hash), _key_equal(equal)
+		{
+			this->rehash(bucket_count);
+			this->insert(first, last);
+		}
+
+		flat_hash_table(const flat_hash_table &other) : _ctrl(empty_ctrl()), _slots(NULL), _capacity(0), _size(0), _growth_left(0), _slot_allocator(other._slot_allocator), _hasher(other._hasher), _key_equal(other._key_equal)
+		{
+			this->copy_slots(other);
+		}
+
+		flat_hash_table( const flat_hash_table& other, const Allocator& alloc ) : _ctrl(empty_ctrl()), _slots(NULL), _capacity(0), _size(0), _growth_left(0), _slot_allocator(alloc), _hasher(other._hasher), _key_equal(other._key_equal)
+		{
+			this->copy_slots(other);
+		}
+
+		~flat_hash_table()
+		{
+			this->destroy_slots();
+			this->deallocate();
+		}
+
+		flat_hash_table& operator=( const flat_hash_table& other ) {
+			if (this == &other)
+				return *this;
+			this->destroy_slots();
+			this->deallocate();
+			this->_slot_allocator = other._slot_allocator;
+			this->_hasher = other._hasher;
+			this->_key_equal = other._key_equal;
+			this->copy_slots(other);
+			return *this;
+		}
+
+		allocator_type get_allocator() const { return this->_slot_allocator; }
+
+		iterator begin() {
+			return this->internal_begin();
+		}
+
+		const_iterator begin() const {
+			return this->internal_begin();
+		}
+
+		iterator end() {
+			return iterator(this->_ctrl + this->_capacity, this->_slots + this->_capacity);
+		}
+
+		const_iterator end() const {
+			return const_iterator(this->_ctrl + this->_capacity, this->_slots + this->_capacity);
+		}
+
+		bool empty() const { return !this->_size; }
+
+		size_type size() const { return this->_size; }
+
+		size_type max_size() const { return this->_slot_allocator.max_size(); }
+
+		// the slots are kept
+		void clear()
+		{
+			this->destroy_slots();
+			if (this->_capacity)
+				this->reset_ctrl();
+			this->_size = 0;
+			this->_growth_left = capacity_to_growth(this->_capacity);
+		}
+
+		ft::pair<iterator, bool> insert( const value_type& value )
+		{
+			size_t hash = this->hash_of(KeyOfValue()(value));
+			iterator it = this->find_hashed(KeyOfValue()(value), hash);
+			if (it != this->end())
+				return ft::pair<iterator, bool>(it, false);
+			return ft::pair<iterator, bool>(this->insert_new(value, hash), true);
+		}
+
+		// the hint is of no use to an open addressing table
+		iterator insert( const_iterator, const value_type& value )
+		{
+			return this->insert(value).first;
+		}
+
+		template< class InputIt >
+		void insert( InputIt first, InputIt last )
+		{
+			while (first != last)
+			{
+				this->insert(*first);
+				++first;
+			}
+		}
+
+		// erasing moves no element, it returns the iterator following pos
+		iterator erase( iterator pos )
+		{
+			return this->erase(const_iterator(pos));
+		}
+
+		iterator erase( const_iterator pos )
+		{
+			iterator ret(pos.ctrl, pos.slot);
+			++ret;
+			this->erase_slot(pos.ctrl - this->_ctrl);
+			return ret;
+		}
+
+		iterator erase( const_iterator first, const_iterator last )
+		{
+			while (first != last)
+				first = this->erase(first);
+			return iterator(last.ctrl, last.slot);
+		}
+
+		size_type erase( const Key& key )
+		{
+			iterator it = this->find(key);
+			if (it == this->end())
+				return 0;
+			this->erase_slot(it.ctrl - this->_ctrl);
+			return 1;
+		}
+
+		void swap( flat_hash_table& other )
+		{
+			ft::swap(this->_ctrl, other._ctrl);
+			ft::swap(this->_slots, other._slots);
+			ft::swap(this->_capacity, other._capacity);
+			ft::swap(this->_size, other._size);
+			ft::swap(this->_growth_left, other._growth_left);
+			ft::swap(this->_slot_allocator, other._slot_allocator);
+			ft::swap(this->_hasher, other._hasher);
+			ft::swap(this->_key_equal, other._key_equal);
+		}
+
+		size_type count( const Key& key ) const
+		{
+			return this->find(key) != this->end();
+		}
+
+		template<class K>
+		typename if_transparent<K, size_type>::type count( const K& key ) const
+		{
+			return this->find_hashed(key, this->hash_of(key)) != this->end();
+		}
+
+		iterator find( const Key& key )
+		{
+			return this->find_hashed(key, this->hash_of(key));
+		}
+
+		const_iterator find( const Key& key ) const
+		{
+			return this->find_hashed(key, this->hash_of(key));
+		}
+
+		template<class K>
+		typename if_transparent<K, iterator>::type find( const K& key )
+		{
+			return this->find_hashed(key, this->hash_of(key));
+		}
+
+		template<class K>
+		typename if_transparent<K, const_iterator>::type find( const K& key ) const
+		{
+			return this->find_hashed(key, this->hash_of(key));
+		}
+
+		ft::pair<iterator,iterator> equal_range( const Key& key )
+		{
+			return this->internal_equal_range(key);
+		}
+
+		ft::pair<const_iterator,const_iterator> equal_range( const Key& key ) const
+		{
+			return this->internal_equal_range(key);
+		}
+
+		template<class K>
+		typename if_transparent<K, ft::pair<iterator,iterator> >::type equal_range( const K& key )
+		{
+			return this->internal_equal_range(key);
+		}
+
+		template<class K>
+		typename if_transparent<K, ft::pair<const_iterator,const_iterator> >::type equal_range( const K& key ) const
+		{
+			return this->internal_equal_range(key);
+		}
+
+		size_type bucket_count() const
+		{
+			return this->_capacity;
+		}
+
+		size_type max_bucket_count() const
+		{
+			return this->_slot_allocator.max_size();
+		}
+
+		float load_factor() const
+		{
+			return this->_capacity ? (float)this->size() / this->_capacity : 0;
+		}
+
+		// the table grows when 7/8 of its slots are used, the maximum load factor cannot be changed
+		float max_load_factor() const
+		{
+			return 0.875;
+		}
+
+		void max_load_factor( float )
+		{
+		}
+
+		// at least count slots, and enough to hold the elements, the tombstones are dropped
+		void rehash( size_type count )
+		{
+			size_type min = growth_to_capacity(this->size());
+			if (count < min)
+				count = min;
+			if (!count)
+				return this->deallocate();
+			this->resize(normalize_capacity(count));
+		}
+
+		// room for count elements without rehashing
+		void reserve( size_type count )
+		{
+			if (count > this->size() + this->_growth_left)
+				this->rehash(growth_to_capacity(count));
+		}
+
+		hasher hash_function() const
+		{
+			return this->_hasher;
+		}
+
+		key_equal key_eq() const
+		{
+			return this->_key_equal;
+		}
+
+	private:
+		static signed char *empty_ctrl()
+		{
+			return const_cast<signed char *>(flat_hash_empty_group<void>::ctrl);
+		}
+
+		// capacities are 2^n - 1 and hold at least a group
+		static size_type normalize_capacity(size_type n)
+		{
+			size_type ret = WIDTH - 1;
+			while (ret < n)
+				ret = ret * 2 + 1;
+			return ret;
+		}
+
+		// at most 7/8 of the slots are used, and always less than all of them so that the probes end
+		static size_type capacity_to_growth(size_type capacity)
+		{
+			return capacity - (capacity + 1) / 8;
+		}
+
+		static size_type growth_to_capacity(size_type growth)
+		{
+			return growth ? growth + growth / 7 + 1 : 0;
+		}
+
+		// the identity hashes of ft::hash would put consecutive integers in the same group with the same H2
+		template<class K>
+		size_t hash_of(const K& key) const
+		{
+			return ft::hash_mix(this->_hasher(key));
+		}
+
+		static signed char h2(size_t hash)
+		{
+			return (signed char)(hash & 0x7F);
+		}
+
+		const_iterator internal_begin() const
+		{
+			const_iterator it(this->_ctrl, this->_slots);
+			if (*it.ctrl < FLAT_HASH_SENTINEL)
+				++it;
+			return it;
+		}
+
+		// the groups are probed in the order offset, offset + WIDTH, offset + 3 * WIDTH, ... which visits all of
+		// them since the number of control bytes is a power of two. the probe stops on a group with an empty slot
+		template<class K>
+		iterator find_hashed(const K& key, size_t hash) const
+		{
+			size_type offset = (hash >> 7) & this->_capacity;
+			size_type step = 0;
+			while (true)
+			{
+				group_type g(this->_ctrl + offset);
+				for (typename group_type::mask_type m = g.match(h2(hash)); m; m = group_type::next(m))
+				{
+					size_type i = (offset + group_type::first(m)) & this->_capacity;
+					if (this->_key_equal(key, KeyOfValue()(this->_slots[i])))
+						return iterator(this->_ctrl + i, this->_slots + i);
+				}
+				if (g.match_empty())
+					return iterator(this->_ctrl + this->_capacity, this->_slots + this->_capacity);
+				step += WIDTH;
+				offset = (offset + step) & this->_capacity;
+			}
+		}
+
+		template<class K>
+		ft::pair<iterator,iterator> internal_equal_range( const K& key ) const
+		{
+			iterator it = this->find_hashed(key, this->hash_of(key));
+			if (it == iterator(this->_ctrl + this->_capacity, this->_slots + this->_capacity))
+				return ft::pair<iterator,iterator>(it, it);
+			iterator next = it;
+			return ft::pair<iterator,iterator>(it, ++next);
+		}
+
+		// first empty or deleted slot on the probe sequence of hash
+		size_type find_free(size_t hash) const
+		{
+			size_type offset = (hash >> 7) & this->_capacity;
+			size_type step = 0;
+			while (true)
+			{
+				typename group_type::mask_type m = group_type(this->_ctrl + offset).match_empty_or_deleted();
+				if (m)
+					return (offset + group_type::first(m)) & this->_capacity;
+				step += WIDTH;
+				offset = (offset + step) & this->_capacity;
+			}
+		}
+
+		// set the control byte of slot i and its copy past the sentinel
+		void set_ctrl(size_type i, signed char c)
+		{
+			this->_ctrl[i] = c;
+			this->_ctrl[((i - (WIDTH - 1)) & this->_capacity) + (WIDTH - 1)] = c;
+		}
+
+		iterator insert_new(const value_type& value, size_t hash)
+		{
+			size_type i = this->find_free(hash);
+			if (!this->_growth_left && this->_ctrl[i] != FLAT_HASH_DELETED)
+			{
+				this->grow();
+				i = this->find_free(hash);
+			}
+			this->_slot_allocator.construct(this->_slots + i, value);
+			if (this->_ctrl[i] == FLAT_HASH_EMPTY)
+				this->_growth_left--;
+			this->set_ctrl(i, h2(hash));
+			this->_size++;
+			return iterator(this->_ctrl + i, this->_slots + i);
+		}
+
+		// a table full of tombstones is rehashed at the same capacity, otherwise it doubles
+		void grow()
+		{
+			if (this->_capacity && this->size() <= capacity_to_growth(this->_capacity) / 2)
+				this->resize(this->_capacity);
+			else
+				this->resize(normalize_capacity(this->_capacity * 2 + 1));
+		}
+
+		// the slot can be emptied when no window of WIDTH full or deleted control bytes contains it: a probe
+		// went past it only when its group had no empty slot
+		void erase_slot(size_type i)
+		{
+			this->_slot_allocator.destroy(this->_slots + i);
+			this->_size--;
+			typename group_type::mask_type empty_before = group_type(this->_ctrl + ((i - WIDTH) & this->_capacity)).match_empty();
+			typename group_type::mask_type empty_after = group_type(this->_ctrl + i).match_empty();
+			if (empty_before && empty_after &&
+				group_type::after_last(empty_before) + group_type::first(empty_after) < WIDTH)
+			{
+				this->set_ctrl(i, FLAT_HASH_EMPTY);
+				this->_growth_left++;
+			}
+			else
+				this->set_ctrl(i, FLAT_HASH_DELETED);
+		}
+
+		void allocate(size_type capacity)
+		{
+			this->_capacity = capacity;
+			this->_ctrl = ctrl_allocator(this->_slot_allocator).allocate(capacity + WIDTH);
+			this->_slots = this->_slot_allocator.allocate(capacity);
+			this->reset_ctrl();
+			this->_growth_left = capacity_to_growth(capacity);
+		}
+
+		void deallocate()
+		{
+			if (!this->_capacity)
+				return;
+			ctrl_allocator(this->_slot_allocator).deallocate(this->_ctrl, this->_capacity + WIDTH);
+			this->_slot_allocator.deallocate(this->_slots, this->_capacity);
+			this->_ctrl = empty_ctrl();
+			this->_slots = NULL;
+			this->_capacity = 0;
+			this->_growth_left = 0;
+		}
+
+		void reset_ctrl()
+		{
+			__builtin_memset(this->_ctrl, FLAT_HASH_EMPTY, this->_capacity + WIDTH);
+			this->_ctrl[this->_capacity] = FLAT_HASH_SENTINEL;
+		}
+
+		// move every element to a new array of slots
+		void resize(size_type capacity)
+		{
+			signed char *old_ctrl = this->_ctrl;
+			value_type *old_slots = this->_slots;
+			size_type old_capacity = this->_capacity;
+			this->allocate(capacity);
+			for (size_type i = 0; i < old_capacity; i++)
+			{
+				if (old_ctrl[i] < 0)
+					continue;
+				size_t hash = this->hash_of(KeyOfValue()(old_slots[i]));
+				size_type j = this->find_free(hash);
+				this->set_ctrl(j, h2(hash));
+				this->_slot_allocator.construct(this->_slots + j, old_slots[i]);
+				this->_slot_allocator.destroy(old_slots + i);
+			}
+			this->_growth_left -= this->size();
+			if (old_capacity)
+			{
+				ctrl_allocator(this->_slot_allocator).deallocate(old_ctrl, old_capacity + WIDTH);
+				this->_slot_allocator.deallocate(old_slots, old_capacity);
+			}
+		}
+
+		// other's layout is copied as is, no element is hashed
+		void copy_slots(const flat_hash_table &other)
+		{
+			this->_size = other._size;
+			if (!other._capacity)
+				return;
+			this->allocate(other._capacity);
+			__builtin_memcpy(this->_ctrl, other._ctrl, this->_capacity + WIDTH);
+			for (size_type i = 0; i < this->_capacity; i++)
+				if (this->_ctrl[i] >= 0)
+					this->_slot_allocator.construct(this->_slots + i, other._slots[i]);
+			this->_growth_left = other._growth_left;
+		}
+
+		void destroy_slots()
+		{
+			if (ft::is_trivially_destructible<value_type>::value)
+				return;
+			for (size_type i = 0; i < this->_capacity; i++)
+				if (this->_ctrl[i] >= 0)
+					this->_slot_allocator.destroy(this->_slots + i);
+		}
+	};
+
+	template< class K, class U, class H, class KE, class A, class KOV >
+	bool operator==( const ft::flat_hash_table<K, U, H, KE, A, KOV>& lhs,
+					 const ft::flat_hash_table<K, U, H, KE, A, KOV>& rhs )
+	{
+		if (lhs.size() != rhs.size())
+			return false;
+		for (typename ft::flat_hash_table<K, U, H, KE, A, KOV>::const_iterator it = lhs.begin(); it != lhs.end(); ++it)
+		{
+			typename ft::flat_hash_table<K, U, H, KE, A, KOV>::const_iterator other = rhs.find(KOV()(*it));
+			if (other == rhs.end() || !(*other == *it))
+				return false;
+		}
+		return true;
+	}
+
+	template< class K, class U, class H, class KE, class A, class KOV >
+	bool operator!=( const ft::flat_hash_table<K, U, H, KE, A, KOV>& lhs,
+					 const ft::flat_hash_table<K, U, H, KE, A, KOV>& rhs )
+	{
+		return !(lhs == rhs);
+	}
+
+	template< class K, class U, class H, class KE, class A, class KOV >
+	void swap( ft::flat_hash_table<K, U, H, KE, A, KOV>& lhs,
+			   ft::flat_hash_table<K, U, H, KE, A, KOV>& rhs )
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef FT_CONTAINERS_FLAT_MAP_HPP
+#define FT_CONTAINERS_FLAT_MAP_HPP
+#include "utility.hpp"
+#include <memory>
+#include "flat_tree.hpp"
+
+namespace ft {
+
+	// the keys are not const in the value_type, since the elements are moved around in the vector
+	template<
+			class Key,
+			class T,
+			class Compare = ft::less <Key>,
+			class Allocator = std::allocator <ft::pair<Key, T> >
+	>
+	class flat_map : public flat_tree<Key, ft::pair<Key, T>, Compare, Allocator, false, get_first> {
+	private:
+		typedef flat_tree<Key, ft::pair<Key, T>, Compare, Allocator, false, get_first> tree_type;
+	public:
+		typedef T											mapped_type;
+		typedef typename tree_type::container_type			container_type;
+
+		flat_map() : tree_type() {}
+
+		explicit flat_map(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		flat_map(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+
+		flat_map(ft::adopt_sorted_t, container_type &sorted, const Compare &comp = Compare()) :
+			tree_type(ft::adopt_sorted, sorted, comp) {}
+
+		template<class InputIt>
+		flat_map(ft::adopt_sorted_t, InputIt first, InputIt last, const Compare &comp = Compare(),
+			const Allocator &alloc = Allocator()) : tree_type(ft::adopt_sorted, first, last, comp, alloc) {}
+
+		T& operator[]( const Key& key )
+		{
+			typename tree_type::iterator it = this->lower_bound(key);
+			if (it == this->end() || this->key_comp()(key, it->first))
+				it = this->insert(it, ft::make_pair(key, mapped_type()));
+			return it->second;
+		}
+	};
+
+	template<
+			class Key,
+			class T,
+			class Compare = ft::less <Key>,
+			class Allocator = std::allocator <ft::pair<Key, T> >
+	>
+	class flat_multimap : public flat_tree<Key, ft::pair<Key, T>, Compare, Allocator, true, get_first> {
+	private:
+		typedef flat_tree<Key, ft::pair<Key, T>, Compare, Allocator, true, get_first> tree_type;
+	public:
+		typedef T											mapped_type;
+		typedef typename tree_type::container_type			container_type;
+
+		flat_multimap() : tree_type() {}
+
+		explicit flat_multimap(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		flat_multimap(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+
+		flat_multimap(ft::adopt_sorted_t, container_type &sorted, const Compare &comp = Compare()) :
+			tree_type(ft::adopt_sorted, sorted, comp) {}
+
+		template<class InputIt>
+		flat_multimap(ft::adopt_sorted_t, InputIt first, InputIt last, const Compare &comp = Compare(),
+			const Allocator &alloc = Allocator()) : tree_type(ft::adopt_sorted, first, last, comp, alloc) {}
+	};
+
+	template<
+			class Key,
+			class T,
+			class Compare,
+			class Allocator
+	>
+	void	swap(ft::flat_map<Key, T, Compare, Allocator> &lhs, ft::flat_map<Key, T, Compare, Allocator> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+
+	template<
+			class Key,
+			class T,
+			class Compare,
+			class Allocator
+	>
+	void	swap(ft::flat_multimap<Key, T, Compare, Allocator> &lhs, ft::flat_multimap<Key, T, Compare, Allocator> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+}
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef FT_CONTAINERS_FLAT_SET_HPP
+#define FT_CONTAINERS_FLAT_SET_HPP
+#include "utility.hpp"
+#include <memory>
+#include "flat_tree.hpp"
+
+namespace ft {
+	template<
+			class Key,
+			class Compare = ft::less<Key>,
+			class Allocator = std::allocator<Key>
+	>
+	class flat_set : public flat_tree<Key, Key, Compare, Allocator> {
+	private:
+		typedef flat_tree<Key, Key, Compare, Allocator> tree_type;
+	public:
+		typedef typename tree_type::container_type			container_type;
+
+		flat_set() : tree_type() {}
+
+		explicit flat_set(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		flat_set(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+
+		flat_set(ft::adopt_sorted_t, container_type &sorted, const Compare &comp = Compare()) :
+			tree_type(ft::adopt_sorted, sorted, comp) {}
+
+		template<class InputIt>
+		flat_set(ft::adopt_sorted_t, InputIt first, InputIt last, const Compare &comp = Compare(),
+			const Allocator &alloc = Allocator()) : tree_type(ft::adopt_sorted, first, last, comp, alloc) {}
+	};
+
+	template<
+			class Key,
+			class Compare = ft::less<Key>,
+			class Allocator = std::allocator<Key>
+	>
+	class flat_multiset : public flat_tree<Key, Key, Compare, Allocator, true> {
+	private:
+		typedef flat_tree<Key, Key, Compare, Allocator, true> tree_type;
+	public:
+		typedef typename tree_type::container_type			container_type;
+
+		flat_multiset() : tree_type() {}
+
+		explicit flat_multiset(const Compare &comp, const Allocator &alloc = Allocator()) :
+			tree_type(comp, alloc){}
+
+		template<class InputIt>
+		flat_multiset(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+			tree_type(first, last, comp, alloc) {}
+
+		flat_multiset(ft::adopt_sorted_t, container_type &sorted, const Compare &comp = Compare()) :
+			tree_type(ft::adopt_sorted, sorted, comp) {}
+
+		template<class InputIt>
+		flat_multiset(ft::adopt_sorted_t, InputIt first, InputIt last, const Compare &comp = Compare(),
+			const Allocator &alloc = Allocator()) : tree_type(ft::adopt_sorted, first, last, comp, alloc) {}
+	};
+
+	template<
+			class Key,
+			class Compare,
+			class Allocator
+	>
+	void	swap(ft::flat_set<Key, Compare, Allocator> &lhs, ft::flat_set<Key, Compare, Allocator> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+
+	template<
+			class Key,
+			class Compare,
+			class Allocator
+	>
+	void	swap(ft::flat_multiset<Key, Compare, Allocator> &lhs, ft::flat_multiset<Key, Compare, Allocator> &rhs)
+	{
+		rhs.swap(lhs);
+	}
+}
+
+#endif
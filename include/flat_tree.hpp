@@ -0,0 +1,390 @@
+#ifndef FT_CONTAINERS_FLAT_TREE_HPP
+#define FT_CONTAINERS_FLAT_TREE_HPP
+#include "utility.hpp"
+#include "iterator.hpp"
+#include <memory>
+#include <cstddef>
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "vector.hpp"
+
+namespace ft {
+	// tag of the constructors taking elements that are already sorted (and without equivalent keys for the
+	// non multi containers), they are kept as they are
+	struct adopt_sorted_t {};
+	static const adopt_sorted_t adopt_sorted = adopt_sorted_t();
+}
+
+// the elements are kept sorted in a vector: lookups are binary searches over contiguous memory, insertions and
+// erasures shift the elements behind them and invalidate the iterators
+template<
+		class	Key,
+		class	Value,
+		class	Compare = ft::less <Key>,
+		class	Allocator = std::allocator <Value>,
+		bool	multi = false,
+		class	KeyOfValue = ft::identity
+>
+class flat_tree {
+public:
+	typedef Key														key_type;
+	typedef Value													value_type;
+	typedef size_t													size_type;
+	typedef ptrdiff_t												difference_type;
+	typedef Allocator												allocator_type;
+	typedef value_type&												reference;
+	typedef const value_type&										const_reference;
+	typedef typename Allocator::pointer								pointer;
+	typedef typename Allocator::const_pointer						const_pointer;
+	typedef Compare													key_compare;
+	typedef ft::vector<Value, Allocator>							container_type;
+	typedef typename container_type::iterator						iterator;
+	typedef typename container_type::const_iterator					const_iterator;
+	typedef typename container_type::reverse_iterator				reverse_iterator;
+	typedef typename container_type::const_reverse_iterator			const_reverse_iterator;
+	class value_compare {
+	public:
+		typedef bool		result_type;
+		typedef value_type	first_argument_type;
+		typedef value_type	second_argument_type;
+		Compare comp;
+		value_compare() : comp() {}
+		value_compare( Compare c ) : comp(c) {}
+		bool operator()( const value_type& lhs, const value_type& rhs ) const
+		{
+			return this->comp(KeyOfValue()(lhs), KeyOfValue()(rhs));
+		}
+	};
+private:
+	enum e_sort {INSERTION_SORT = 16};
+	Compare compare;
+	value_compare _value_comp;
+	container_type values;
+public:
+	flat_tree() : compare(), _value_comp(compare), values() {}
+
+	explicit flat_tree(const Compare &comp, const Allocator &alloc = Allocator()) : compare(comp), _value_comp(comp),
+	values(alloc) {}
+
+	template<class InputIt>
+	flat_tree(InputIt first, InputIt last, const Compare &comp = Compare(), const Allocator &alloc = Allocator()) :
+	compare(comp), _value_comp(comp), values(alloc) {
+		this->insert(first, last);
+	}
+
+	// the content of sorted is taken in O(1), sorted is left empty
+	flat_tree(ft::adopt_sorted_t, container_type &sorted, const Compare &comp = Compare()) : compare(comp),
+	_value_comp(comp), values(sorted.get_allocator()) {
+		this->values.swap(sorted);
+	}
+
+	template<class InputIt>
+	flat_tree(ft::adopt_sorted_t, InputIt first, InputIt last, const Compare &comp = Compare(),
+		const Allocator &alloc = Allocator()) : compare(comp), _value_comp(comp), values(first, last, alloc) {}
+
+	flat_tree(const flat_tree &other) : compare(other.compare), _value_comp(other._value_comp), values(other.values) {}
+
+	flat_tree &operator=(const flat_tree &other) {
+		this->compare = other.compare;
+		this->_value_comp = other._value_comp;
+		this->values = other.values;
+		return *this;
+	}
+
+	allocator_type get_allocator() const { return this->values.get_allocator(); }
+
+	iterator begin() { return this->values.begin(); }
+
+	const_iterator begin() const { return this->values.begin(); }
+
+	iterator end() { return this->values.end(); }
+
+	const_iterator end() const { return this->values.end(); }
+
+	reverse_iterator rbegin() { return this->values.rbegin(); }
+
+	const_reverse_iterator rbegin() const { return this->values.rbegin(); }
+
+	reverse_iterator rend() { return this->values.rend(); }
+
+	const_reverse_iterator rend() const { return this->values.rend(); }
+
+	bool empty() const { return this->values.empty(); }
+
+	size_type size() const { return this->values.size(); }
+
+	size_type max_size() const { return this->values.max_size(); }
+
+	void reserve(size_type new_cap) { this->values.reserve(new_cap); }
+
+	size_type capacity() const { return this->values.capacity(); }
+
+	void clear() { this->values.clear(); }
+
+	typename ft::conditional<multi, iterator, ft::pair<iterator, bool> >::type insert(const value_type &value) {
+		return this->insert(value, ft::integral_constant<bool, !multi>());
+	}
+private:
+	ft::pair<iterator, bool> insert(const value_type &value, ft::true_type) {
+		iterator pos = this->lower_bound(KeyOfValue()(value));
+		if (pos != this->end() && !this->compare(KeyOfValue()(value), KeyOfValue()(*pos)))
+			return ft::make_pair(pos, false);
+		return ft::make_pair(this->values.insert(pos, value), true);
+	}
+
+	iterator insert(const value_type &value, ft::false_type) {
+		return this->values.insert(this->upper_bound(KeyOfValue()(value)), value);
+	}
+public:
+	iterator insert(iterator pos, const value_type &value) {
+		if (multi)
+		{
+			// as close to pos as possible: before it if prev <= value <= pos, after it if pos < value <= next
+			if (pos == this->end() || !this->_value_comp(*pos, value))
+			{
+				if (pos == this->begin() || !this->_value_comp(value, *(pos - 1)))
+					return this->values.insert(pos, value);
+				return this->insert(value, ft::false_type());
+			}
+			if (pos + 1 == this->end() || !this->_value_comp(*(pos + 1), value))
+				return this->values.insert(pos + 1, value);
+			return this->values.insert(this->lower_bound(KeyOfValue()(value)), value);
+		}
+		// if prev < value < pos
+		if ((pos == this->end() || this->_value_comp(value, *pos)) &&
+			(pos == this->begin() || this->_value_comp(*(pos - 1), value)))
+			return this->values.insert(pos, value);
+		return this->insert(value, ft::true_type()).first;
+	}
+
+	// the elements are appended, sorted and merged with the others in one pass
+	template<class InputIt>
+	void insert(InputIt f, InputIt l) {
+		size_type old_size = this->size();
+		for (; f != l; f++)
+			this->values.push_back(*f);
+		this->merge_tail(old_size);
+	}
+
+	void erase(iterator pos) {
+		this->values.erase(pos);
+	}
+
+	void erase(iterator f, iterator l) {
+		this->values.erase(f, l);
+	}
+
+	size_type erase(const Key &key) {
+		ft::pair<iterator, iterator> range = this->equal_range(key);
+		size_type ret = range.second - range.first;
+		this->values.erase(range.first, range.second);
+		return ret;
+	}
+
+	void swap(flat_tree &other) {
+		ft::swap(this->compare, other.compare);
+		ft::swap(this->_value_comp, other._value_comp);
+		this->values.swap(other.values);
+	}
+
+	size_type count(const Key &key) const {
+		if (!multi)
+			return this->find(key) != this->end();
+		return this->upper_bound(key) - this->lower_bound(key);
+	}
+
+	iterator find(const Key &key) {
+		iterator ret = this->lower_bound(key);
+		if (ret == this->end() || this->compare(key, KeyOfValue()(*ret)))
+			return this->end();
+		return ret;
+	}
+
+	const_iterator find(const Key &key) const {
+		const_iterator ret = this->lower_bound(key);
+		if (ret == this->end() || this->compare(key, KeyOfValue()(*ret)))
+			return this->end();
+		return ret;
+	}
+
+	ft::pair<iterator,iterator> equal_range( const Key& key )
+	{
+		return ft::make_pair<iterator,iterator>(this->lower_bound(key), this->upper_bound(key));
+	}
+
+	ft::pair<const_iterator,const_iterator> equal_range( const Key& key ) const
+	{
+		return ft::make_pair<const_iterator,const_iterator>(this->lower_bound(key), this->upper_bound(key));
+	}
+
+	iterator upper_bound( const Key& key ) {
+		return this->begin() + (internal_upper_bound(key) - this->values.begin());
+	}
+
+	const_iterator upper_bound( const Key& key ) const {
+		return internal_upper_bound(key);
+	}
+
+	iterator lower_bound( const Key& key ) {
+		return this->begin() + (internal_lower_bound(key) - this->values.begin());
+	}
+
+	const_iterator lower_bound( const Key& key ) const {
+		return internal_lower_bound(key);
+	}
+
+	key_compare key_comp() const {return this->compare;}
+
+	value_compare value_comp() const {return this->_value_comp;}
+
+	friend bool operator==(const flat_tree &lhs, const flat_tree &rhs) {
+		return ((lhs.size() == rhs.size()) && ft::equal<const_iterator, const_iterator>(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+	friend bool operator!=(const flat_tree &lhs, const flat_tree &rhs) {
+		return (!(lhs == rhs));
+	}
+	friend bool operator<(const flat_tree &lhs, const flat_tree &rhs) {
+		return (ft::lexicographical_compare<const_iterator, const_iterator>(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+	friend bool operator<=(const flat_tree &lhs, const flat_tree &rhs) {
+		return (!(rhs < lhs));
+	}
+	friend bool operator>(const flat_tree &lhs, const flat_tree &rhs) {
+		return (rhs < lhs);
+	}
+	friend bool operator>=(const flat_tree &lhs, const flat_tree &rhs) {
+		return (!(lhs < rhs));
+	}
+private:
+	// the halving steps don't depend on the comparisons so they compile without branches
+
+	// first element whose key is not less than key
+	const_iterator internal_lower_bound(const Key &key) const
+	{
+		const_iterator first = this->values.begin();
+		size_type count = this->values.size();
+		while (count > 1)
+		{
+			size_type half = count / 2;
+			if (this->compare(KeyOfValue()(first[half]), key))
+				first += half;
+			count -= half;
+		}
+		if (count && this->compare(KeyOfValue()(*first), key))
+			first++;
+		return first;
+	}
+
+	// first element whose key is greater than key
+	const_iterator internal_upper_bound(const Key &key) const
+	{
+		const_iterator first = this->values.begin();
+		size_type count = this->values.size();
+		while (count > 1)
+		{
+			size_type half = count / 2;
+			if (!this->compare(key, KeyOfValue()(first[half])))
+				first += half;
+			count -= half;
+		}
+		if (count && !this->compare(key, KeyOfValue()(*first)))
+			first++;
+		return first;
+	}
+
+	// sort the elements from index from (appended by insert(f, l)) and merge them with the ones before, the
+	// elements already there stay first among the equivalent ones, then only the first one is kept in unique trees
+	void	merge_tail(size_type from)
+	{
+		iterator mid = this->begin() + from;
+		iterator last = this->end();
+		if (mid == last)
+			return;
+		if (!this->is_sorted(mid, last))
+		{
+			container_type buffer(mid, last);
+			this->sort(buffer.begin(), mid, last - mid);
+		}
+		if (mid != this->begin() && this->_value_comp(*mid, *(mid - 1)))
+		{
+			container_type tail(mid, last);
+			const_iterator t = tail.end();
+			while (t != tail.begin())
+			{
+				if (mid != this->begin() && this->_value_comp(*(t - 1), *(mid - 1)))
+					*--last = ft::move(*--mid);
+				else
+					*--last = ft::move(*--t);
+			}
+		}
+		if (!multi)
+			this->unique(mid == this->begin() ? mid : mid - 1);
+	}
+
+	bool	is_sorted(const_iterator first, const_iterator last) const
+	{
+		for (first++; first < last; first++)
+			if (this->_value_comp(*first, *(first - 1)))
+				return false;
+		return true;
+	}
+
+	// stable sort of the count elements of dst, src holds the same elements and is used as scratch
+	void	sort(iterator src, iterator dst, size_type count)
+	{
+		if (count <= INSERTION_SORT)
+			return this->insertion_sort(dst, count);
+		size_type half = count / 2;
+		this->sort(dst, src, half);
+		this->sort(dst + half, src + half, count - half);
+		iterator l = src;
+		iterator r = src + half;
+		iterator end = src + count;
+		while (l != src + half && r != end)
+			*dst++ = ft::move(this->_value_comp(*r, *l) ? *r++ : *l++);
+		while (l != src + half)
+			*dst++ = ft::move(*l++);
+		while (r != end)
+			*dst++ = ft::move(*r++);
+	}
+
+	void	insertion_sort(iterator first, size_type count)
+	{
+		for (size_type i = 1; i < count; i++)
+		{
+			if (!this->_value_comp(first[i], first[i - 1]))
+				continue;
+			value_type tmp = ft::move(first[i]);
+			size_type j = i;
+			for (; j > 0 && this->_value_comp(tmp, first[j - 1]); j--)
+				first[j] = ft::move(first[j - 1]);
+			first[j] = ft::move(tmp);
+		}
+	}
+
+	// drop the elements equivalent to the one before them, from first
+	void	unique(iterator first)
+	{
+		iterator kept = first;
+		for (iterator it = first + 1; it < this->end(); it++)
+			if (this->_value_comp(*kept, *it) && ++kept != it)
+				*kept = ft::move(*it);
+		this->values.erase(kept + 1, this->end());
+	}
+};
+
+template<
+		class	Key,
+		class	Value,
+		class	Compare,
+		class	Allocator,
+		bool	multi,
+		class	KeyOfValue
+>
+void swap( flat_tree<Key, Value, Compare, Allocator, multi, KeyOfValue>& lhs,
+		   flat_tree<Key, Value, Compare, Allocator, multi, KeyOfValue>& rhs )
+{
+	lhs.swap(rhs);
+}
+
+#endif
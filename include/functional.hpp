@@ -2,9 +2,10 @@
 # define FT_CONTAINERS_FUNCTIONAL_HPP
 
 #include <string>
+#include "type_traits.hpp"
 
 namespace ft {
-	template<class T>
+	template<class T = void>
 	struct less {
 		typedef bool	result_type;
 		typedef T		first_argument_type;
@@ -16,7 +17,19 @@ namespace ft {
 		}
 	};
 
-	template<class T>
+	// less<> compares any two types, which makes the lookups of the trees accept keys of another type
+	template<>
+	struct less<void> {
+		typedef void	is_transparent;
+
+		template<class L, class R>
+		bool operator()(const L& lhs, const R& rhs) const
+		{
+			return lhs < rhs;
+		}
+	};
+
+	template<class T = void>
 	struct equal_to {
 		typedef bool	result_type;
 		typedef T		first_argument_type;
@@ -28,6 +41,17 @@ namespace ft {
 		}
 	};
 
+	template<>
+	struct equal_to<void> {
+		typedef void	is_transparent;
+
+		template<class L, class R>
+		bool operator()(const L& lhs, const R& rhs) const
+		{
+			return lhs == rhs;
+		}
+	};
+
 	template <typename ArgumentType, typename ResultType>
 	struct unary_function
 	{
@@ -72,6 +96,25 @@ namespace ft {
 		}
 	};
 
+	// finalizer spreading every bit of a hash over the whole word, for the tables which use the low bits of the
+	// hashes: the identity hashes of the integers would otherwise put consecutive keys together. the 128 bits product
+	// with an odd constant is folded on itself where it is available, otherwise the murmur3 finalizer is used
+	inline size_t hash_mix(size_t h)
+	{
+#if defined(__SIZEOF_INT128__)
+		__uint128_t p = (__uint128_t)h * 0x9E3779B97F4A7C15ULL;
+		return (size_t)(p ^ (p >> 64));
+#else
+		unsigned long long x = h;
+		x ^= x >> 33;
+		x *= 0xFF51AFD7ED558CCDULL;
+		x ^= x >> 33;
+		x *= 0xC4CEB9FE1A85EC53ULL;
+		x ^= x >> 33;
+		return (size_t)x;
+#endif
+	}
+
 	template< class Key >
 	struct hash
 	{
@@ -80,6 +123,110 @@ namespace ft {
 		size_t operator()(const Key &key) const;
 	};
 
+	// byte hashing of the strings and of the keys without an integral representation, on the scheme of wyhash:
+	// the input is read 8 bytes at a time and every pair of words is folded into the state through a 64x64->128 bits
+	// multiplication. keys longer than 48 bytes run three independent states to keep the multiplier busy
+	struct hash_bytes_impl {
+		static unsigned long long read8(const unsigned char *p)
+		{
+			unsigned long long ret;
+			__builtin_memcpy(&ret, p, 8);
+			return ret;
+		}
+
+		static unsigned long long read4(const unsigned char *p)
+		{
+			unsigned int ret;
+			__builtin_memcpy(&ret, p, 4);
+			return ret;
+		}
+
+		// 1 to 3 bytes, the first, middle and last ones
+		static unsigned long long read3(const unsigned char *p, size_t len)
+		{
+			return ((unsigned long long)p[0] << 16) | ((unsigned long long)p[len >> 1] << 8) | p[len - 1];
+		}
+
+		// full 128 bits product of a and b, the low half in a and the high half in b
+		static void mum(unsigned long long &a, unsigned long long &b)
+		{
+#if defined(__SIZEOF_INT128__)
+			__uint128_t r = (__uint128_t)a * b;
+			a = (unsigned long long)r;
+			b = (unsigned long long)(r >> 64);
+#else
+			unsigned long long ha = a >> 32, hb = b >> 32, la = (unsigned int)a, lb = (unsigned int)b;
+			unsigned long long rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+			unsigned long long t = rl + (rm0 << 32), c = t < rl;
+			unsigned long long lo = t + (rm1 << 32);
+			c += lo < t;
+			a = lo;
+			b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+		}
+
+		static unsigned long long mix(unsigned long long a, unsigned long long b)
+		{
+			mum(a, b);
+			return a ^ b;
+		}
+
+		static size_t hash(const void *key, size_t len)
+		{
+			static const unsigned long long secret[4] = {
+				0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+			};
+			const unsigned char	*p = static_cast<const unsigned char *>(key);
+			unsigned long long	seed = mix(secret[0], secret[1]);
+			unsigned long long	a;
+			unsigned long long	b;
+
+			if (len <= 16)
+			{
+				if (len >= 4)
+				{
+					a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+					b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+				}
+				else
+				{
+					a = len ? read3(p, len) : 0;
+					b = 0;
+				}
+			}
+			else
+			{
+				size_t i = len;
+				if (i > 48)
+				{
+					unsigned long long see1 = seed, see2 = seed;
+					do {
+						seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+						see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+						see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= see1 ^ see2;
+				}
+				for (; i > 16; i -= 16, p += 16)
+					seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+				// the last 16 bytes, overlapping the ones already read
+				a = read8(p + i - 16);
+				b = read8(p + i - 8);
+			}
+			a ^= secret[1];
+			b ^= seed;
+			mum(a, b);
+			return (size_t)mix(a ^ secret[0] ^ len, b ^ secret[1]);
+		}
+	};
+
+	inline size_t hash_bytes(const void *key, size_t len)
+	{
+		return hash_bytes_impl::hash(key, len);
+	}
+
 	template<> struct hash<bool> : public identity {};
 
 	template<> struct hash<char> : public identity {};
@@ -89,29 +236,75 @@ namespace ft {
 	template<> struct hash<short> : public identity {};
 	template<> struct hash<unsigned short> : public identity {};
 	template<> struct hash<int> : public identity {};
-	template<> struct hash<unsigned int>;
+	template<> struct hash<unsigned int> : public identity {};
 	template<> struct hash<long> : public identity {};
 	template<> struct hash<long long> : public identity {};
 	template<> struct hash<unsigned long> : public identity {};
 	template<> struct hash<unsigned long long> : public identity {};
-	template<> struct hash<float>;
-	template<> struct hash<double>;
-	template<> struct hash<long double>;
+
+	// the floating points hash their representation, with -0.0 and +0.0, equal, sent to the same value
+	template<> struct hash<float> {
+		size_t operator()(float key) const
+		{
+			unsigned int bits = 0;
+			if (key != 0)
+				__builtin_memcpy(&bits, &key, sizeof(key));
+			return bits;
+		}
+	};
+
+	template<> struct hash<double> {
+		size_t operator()(double key) const
+		{
+			unsigned long long bits = 0;
+			if (key != 0)
+				__builtin_memcpy(&bits, &key, sizeof(key));
+			// keep the mantissa of the doubles holding small integers, all in the high word, in the low bits
+			return (size_t)(bits ^ (bits >> 32));
+		}
+	};
+
+	template<> struct hash<long double> {
+		size_t operator()(long double key) const
+		{
+			if (key == 0)
+				return 0;
+			// the x87 extended format only uses the first 10 bytes, the rest is padding of unspecified value
+#if __LDBL_MANT_DIG__ == 64
+			return hash_bytes(&key, 10);
+#else
+			return hash_bytes(&key, sizeof(key));
+#endif
+		}
+	};
+
 //	template<> struct hash<std::nullptr_t>;
-	template< class T > struct hash<T*>;
+
+	// the low bits of the addresses are zero from the alignment of the allocations, they are rotated away instead
+	// of shifted out so that pointers to the bytes of an object stay distinct
+	template< class T > struct hash<T*> {
+		size_t operator()(T *key) const
+		{
+			size_t p = reinterpret_cast<size_t>(key);
+			return (p >> 3) | (p << (sizeof(size_t) * 8 - 3));
+		}
+	};
+
 	template<> struct hash<std::string> {
-		// http://www.cse.yorku.ca/~oz/hash.html
 		size_t operator()(const std::string &key) const
 		{
-			unsigned long hash = 5381;
-//			int c;
-
-			for (std::string::const_iterator it = key.begin(); it != key.end(); it++)
-				hash = ((hash << 5) + hash) + *it; /* hash * 33 + c */
-
-			return hash;
+			return hash_bytes(key.data(), key.size());
 		}
 	};
+
+	// whether a hasher is cheap enough for the hash tables to recompute it instead of storing it in the nodes.
+	// only the hashes of the integers, floating points and pointers are, a user hasher can specialize it
+	template<class Hash> struct is_fast_hash : public ft::false_type {};
+	template<class T> struct is_fast_hash< hash<T> > : public ft::is_integral<T> {};
+	template<class T> struct is_fast_hash< hash<T*> > : public ft::true_type {};
+	template<> struct is_fast_hash< hash<signed char> > : public ft::true_type {};
+	template<> struct is_fast_hash< hash<float> > : public ft::true_type {};
+	template<> struct is_fast_hash< hash<double> > : public ft::true_type {};
 }
 
 #endif
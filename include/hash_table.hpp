@@ -16,6 +16,46 @@
 #define	FT_HASH_TABLE_BASE_SIZE 1
 
 namespace ft {
+	// bucket policies of hash_table: the bucket counts used and how a hash is turned into a bucket index
+
+	// power of two bucket counts, the low bits of the mixed hash give the bucket without a division
+	struct hash_table_pow2_policy {
+		static size_t bucket_count(size_t n)
+		{
+			size_t ret = 1;
+			while (ret < n)
+				ret <<= 1;
+			return ret;
+		}
+
+		static size_t index(size_t hash, size_t bucket_count)
+		{
+			return ft::hash_mix(hash) & (bucket_count - 1);
+		}
+	};
+
+	// prime bucket counts, the hash is taken modulo the bucket count as is
+	struct hash_table_prime_policy {
+		static size_t bucket_count(size_t n)
+		{
+			static const unsigned long primes[] = {
+				1ul, 5ul, 11ul, 23ul, 53ul, 97ul, 193ul, 389ul, 769ul, 1543ul, 3079ul, 6151ul, 12289ul, 24593ul,
+				49157ul, 98317ul, 196613ul, 393241ul, 786433ul, 1572869ul, 3145739ul, 6291469ul, 12582917ul,
+				25165843ul, 50331653ul, 100663319ul, 201326611ul, 402653189ul, 805306457ul, 1610612741ul,
+				3221225473ul, 4294967291ul
+			};
+			for (size_t i = 0; i < sizeof(primes) / sizeof(*primes); i++)
+				if (primes[i] >= n)
+					return primes[i];
+			return n | 1;
+		}
+
+		static size_t index(size_t hash, size_t bucket_count)
+		{
+			return hash % bucket_count;
+		}
+	};
+
 template <
 		class	Key,
 		class	Value,
@@ -23,7 +63,9 @@ template <
 		class	KeyEqual = ft::equal_to<Key>,
 		class	Allocator = std::allocator <Key>,
         bool	multi = false,
-		class	KeyOfValue = ft::identity
+		class	KeyOfValue = ft::identity,
+		class	BucketPolicy = ft::hash_table_pow2_policy,
+		bool	cache_hash = !ft::is_fast_hash<Hash>::value
         >
 	class hash_table {
 	public:
@@ -40,10 +82,23 @@ template <
 		typedef typename Allocator::const_pointer	const_pointer;
 
 	private:
-		struct Node {
-			Node		*next;
+		// with cache_hash the full hash of the key is kept in the node: rehash never calls the hasher and the
+		// lookups compare the hashes before calling key_equal
+		template<bool cached, class Dummy = void>
+		struct node_t {
+			node_t		*next;
 			value_type	value;
+			size_t		hash;
 		};
+
+		template<class Dummy>
+		struct node_t<false, Dummy> {
+			node_t		*next;
+			value_type	value;
+		};
+
+		typedef node_t<cache_hash>													Node;
+		typedef ft::integral_constant<bool, cache_hash>							cache_hash_type;
 		typedef typename allocator_type::template rebind<Node>::other				node_allocator;
 		typedef Node																*bucket_type;
 		typedef typename allocator_type::template rebind<bucket_type>::other		bucket_allocator;
@@ -51,6 +106,10 @@ template <
 		typedef typename table_type::iterator										bucket_iterator;
 		typedef typename table_type::const_iterator									const_bucket_iterator;
 
+		// the lookups taking any key type K exist only when both the hasher and key_equal declare is_transparent
+		template<class K, class R>
+		struct if_transparent : public ft::enable_if<ft::is_transparent<Hash>::value && ft::is_transparent<KeyEqual>::value, R> {};
+
 		template<typename pointed_type>
 		struct local_iterator_t {
 			typedef ptrdiff_t					difference_type;
@@ -168,7 +227,7 @@ template <
 		explicit hash_table( size_type bucket_count,
 								const Hash& hash = Hash(),
 								const key_equal& equal = key_equal(),
-								const Allocator& alloc = Allocator() ) : table(bucket_count, NULL, alloc), _size(0), _node_allocator(alloc), _first_occupied_bucket(bucket_count), _hasher(hash), _key_equal(equal), _max_load_factor(1.0) {}
+								const Allocator& alloc = Allocator() ) : table(BucketPolicy::bucket_count(bucket_count), NULL, alloc), _size(0), _node_allocator(alloc), _first_occupied_bucket(table.size()), _hasher(hash), _key_equal(equal), _max_load_factor(1.0) {}
 
 		explicit hash_table( const Allocator& alloc ) : table(FT_HASH_TABLE_BASE_SIZE, NULL, alloc), _size(0), _node_allocator(alloc), _first_occupied_bucket(FT_HASH_TABLE_BASE_SIZE), _max_load_factor(1.0) {}
 
@@ -177,7 +236,7 @@ template <
 		size_type bucket_count = FT_HASH_TABLE_BASE_SIZE,
 		const Hash& hash = Hash(),
 		const key_equal& equal = key_equal(),
-		const Allocator& alloc = Allocator() ) : table(bucket_count, NULL, alloc), _node_allocator(alloc), _size(0), _first_occupied_bucket(bucket_count), _hasher(hash), _key_equal(equal), _max_load_factor(1.0)
+		const Allocator& alloc = Allocator() ) : table(BucketPolicy::bucket_count(bucket_count), NULL, alloc), _node_allocator(alloc), _size(0), _first_occupied_bucket(table.size()), _hasher(hash), _key_equal(equal), _max_load_factor(1.0)
 		{
 			this->insert(first, last);
 		}
@@ -258,36 +317,37 @@ template <
 
 	private:
 
+		// grow to at least the next bucket count of the policy, about twice the current one for both of them
 		void			check_load_factor(size_type count)
 		{
 			if ((float)(this->size() + count) / this->bucket_count() > this->_max_load_factor)
-				this->reserve(this->size() + count);
+				this->rehash(ft::max<size_type>((this->size() + count) / this->_max_load_factor + 1, this->bucket_count() + 1));
 		}
 
-		local_iterator find_in_bucket(size_type bucket, const value_type& value)
+		local_iterator find_in_bucket(size_type bucket, size_t hash, const value_type& value)
 		{
 			local_iterator it;
 			for (it = this->begin(bucket); it != this->end(bucket); it++)
-				if (_key_equal(KeyOfValue()(*it), KeyOfValue()(value)))
+				if (this->node_matches(it.current, hash, KeyOfValue()(value)))
 					break;
 			return it;
 		}
 
-		ft::pair<iterator,bool> insert_in_bucket( size_type bucket, const value_type& value, local_iterator hint = NULL)
+		ft::pair<iterator,bool> insert_in_bucket( size_type bucket, size_t hash, const value_type& value, local_iterator hint = NULL)
 		{
 			local_iterator it;
 			Node *n;
-			if (hint != this->end(bucket) && _key_equal(KeyOfValue()(*hint), KeyOfValue()(value)) && multi)
+			if (hint != this->end(bucket) && multi && this->node_matches(hint.current, hash, KeyOfValue()(value)))
 			{
-				n = new_node((Node){hint.current->next, value});
+				n = new_node(hint.current->next, value, hash);
 				hint.current->next = n;
 			}
 			else
 			{
-				it = find_in_bucket(bucket, value);
+				it = find_in_bucket(bucket, hash, value);
 				if (it != this->end(bucket) && !multi)
 					return ft::pair<iterator,bool>(iterator(&this->table.front() +  bucket, &this->table.front() + this->table.size(), it.current), false);
-				n = new_node((Node){it.current, value});
+				n = new_node(it.current, value, hash);
 				get_node_ref(get_it(bucket, it.current)) = n;
 			}
 
@@ -300,7 +360,8 @@ template <
 		ft::pair<iterator,bool> insert( const value_type& value , ft::true_type)
 		{
 			this->check_load_factor(1);
-			return this->insert_in_bucket(this->bucket(KeyOfValue()(value)), value);
+			size_t hash = this->_hasher(KeyOfValue()(value));
+			return this->insert_in_bucket(BucketPolicy::index(hash, this->bucket_count()), hash, value);
 		}
 
 		iterator insert(const value_type &value, ft::false_type) {
@@ -316,12 +377,14 @@ template <
 		iterator insert( const_iterator hint, const value_type& value )
 		{
 			this->check_load_factor(1);
-			if (hint != this->end() && this->bucket(KeyOfValue()(value)) == (size_type)(hint.current_bucket - &this->table.front())) {
-				ft::pair<iterator, bool> ret = this->insert_in_bucket(hint.current_bucket - &this->table.front(), value, hint.current_node);
+			size_t hash = this->_hasher(KeyOfValue()(value));
+			size_type bucket = BucketPolicy::index(hash, this->bucket_count());
+			if (hint != this->end() && bucket == (size_type)(hint.current_bucket - &this->table.front())) {
+				ft::pair<iterator, bool> ret = this->insert_in_bucket(bucket, hash, value, hint.current_node);
 				if (ret.second)
 					return ret.first;
 			}
-			return this->insert(value, ft::true_type()).first;
+			return this->insert_in_bucket(bucket, hash, value).first;
 		}
 
 		template< class InputIt >
@@ -414,10 +477,25 @@ template <
 		}
 
 		size_type count( const Key& key ) const
+		{
+			return this->internal_count(key);
+		}
+
+		template<class K>
+		typename if_transparent<K, size_type>::type count( const K& key ) const
+		{
+			return this->internal_count(key);
+		}
+
+	private:
+
+		template<class K>
+		size_type internal_count( const K& key ) const
 		{
 			size_type ret = 0;
-			iterator it = this->find(key);
-			while (it != this->end() && this->_key_equal(KeyOfValue()(*it), key))
+			size_t hash = this->_hasher(key);
+			const_iterator it = this->internal_find(key, hash);
+			while (it != this->end() && this->node_matches(it.current_node, hash, key))
 			{
 				it++;
 				ret++;
@@ -425,13 +503,18 @@ template <
 			return ret;
 		}
 
-	private:
+		template<class K>
+		const_iterator internal_find( const K& key ) const
+		{
+			return this->internal_find(key, this->_hasher(key));
+		}
 
-		const_iterator internal_find( const Key& key ) const
+		template<class K>
+		const_iterator internal_find( const K& key, size_t hash ) const
 		{
-			size_t bucket = this->bucket(key);
+			size_t bucket = BucketPolicy::index(hash, this->bucket_count());
 			for (const_local_iterator it = this->begin(bucket); it != this->end(bucket); it++)
-				if (this->_key_equal(key, KeyOfValue()(*it)))
+				if (this->node_matches(it.current, hash, key))
 					return get_it(bucket, it.current);
 			return this->end();
 		}
@@ -446,19 +529,32 @@ template <
 			return this->internal_find(key);
 		}
 
+		template<class K>
+		typename if_transparent<K, iterator>::type find( const K& key )
+		{
+			return this->internal_find(key);
+		}
+
+		template<class K>
+		typename if_transparent<K, const_iterator>::type find( const K& key ) const
+		{
+			return this->internal_find(key);
+		}
+
 	private:
 
-	ft::pair<const_iterator,const_iterator> internal_equal_range( const Key& key ) const
+	template<class K>
+	ft::pair<const_iterator,const_iterator> internal_equal_range( const K& key ) const
 	{
 		size_t hash = this->_hasher(key);
-		hash %= this->bucket_count();
-		for (const_local_iterator it = this->begin(hash); it != this->end(hash); it++)
-			if (this->_key_equal(key, KeyOfValue()(*it)))
+		size_t bucket = BucketPolicy::index(hash, this->bucket_count());
+		for (const_local_iterator it = this->begin(bucket); it != this->end(bucket); it++)
+			if (this->node_matches(it.current, hash, key))
 			{
-				const_iterator it2 = get_it(hash, it.current);
-				while (it2 != this->end() && this->_key_equal(key, KeyOfValue()(*it2)))
+				const_iterator it2 = get_it(bucket, it.current);
+				while (it2 != this->end() && this->node_matches(it2.current_node, hash, key))
 					it2++;
-				return ft::pair<const_iterator,const_iterator>(get_it(hash, it.current), it2);
+				return ft::pair<const_iterator,const_iterator>(get_it(bucket, it.current), it2);
 			}
 		return ft::pair<const_iterator,const_iterator>(this->end(), this->end());
 	}
@@ -475,6 +571,18 @@ template <
 			return this->internal_equal_range(key);
 		}
 
+		template<class K>
+		typename if_transparent<K, ft::pair<const_iterator,const_iterator> >::type equal_range( const K& key ) const
+		{
+			return this->internal_equal_range(key);
+		}
+
+		template<class K>
+		typename if_transparent<K, ft::pair<iterator,iterator> >::type equal_range( const K& key )
+		{
+			return this->internal_equal_range(key);
+		}
+
 	public:
 
 		local_iterator begin( size_type n )
@@ -514,11 +622,19 @@ template <
 
 		size_type bucket( const Key& key ) const
 		{
-			size_t hash = this->_hasher(key);
-			hash %= this->bucket_count();
-			return hash;
+			return this->key_bucket(key);
 		}
 
+	private:
+
+		template<class K>
+		size_type key_bucket( const K& key ) const
+		{
+			return BucketPolicy::index(this->_hasher(key), this->bucket_count());
+		}
+
+	public:
+
 		float load_factor() const
 		{
 			return this->size() / this->bucket_count();
@@ -539,6 +655,7 @@ template <
 			size_type new_size = this->size() / max_load_factor();
 			if (count > new_size)
 				new_size = count;
+			new_size = BucketPolicy::bucket_count(new_size);
 
 			table_type new_table(new_size, NULL, this->_node_allocator);
 			size_t	old_bucket = new_size + 1;
@@ -546,8 +663,7 @@ template <
 			size_t first_bucket = new_size;
 			for (iterator it = this->begin(); it != this->end();it++, previous_node->next = NULL)
 			{
-				size_t bucket = this->_hasher(KeyOfValue()(*it));
-				bucket %= new_table.size();
+				size_t bucket = BucketPolicy::index(this->node_hash(it.current_node, cache_hash_type()), new_table.size());
 				if (bucket < first_bucket)
 					first_bucket = bucket;
 				if (bucket == old_bucket)
@@ -571,8 +687,9 @@ template <
 
 		void reserve( size_type count )
 		{
-			count = count > 10 * this->bucket_count() ? count : 10 * bucket_count();
-			this->rehash(count / max_load_factor() + 1);
+			size_type buckets = count / max_load_factor() + 1;
+			if (buckets > this->bucket_count())
+				this->rehash(buckets);
 		}
 
 		hasher hash_function() const
@@ -631,6 +748,48 @@ template <
 			return ret;
 		}
 
+		Node			*new_node(Node *next, const value_type &value, size_t hash)
+		{
+			return this->new_node(make_node(next, value, hash, cache_hash_type()));
+		}
+
+		static Node		make_node(Node *next, const value_type &value, size_t hash, ft::true_type)
+		{
+			return (Node){next, value, hash};
+		}
+
+		static Node		make_node(Node *next, const value_type &value, size_t, ft::false_type)
+		{
+			return (Node){next, value};
+		}
+
+		size_t	node_hash(const Node *n, ft::true_type) const
+		{
+			return n->hash;
+		}
+
+		size_t	node_hash(const Node *n, ft::false_type) const
+		{
+			return this->_hasher(KeyOfValue()(n->value));
+		}
+
+		bool	hash_matches(const Node *n, size_t hash, ft::true_type) const
+		{
+			return n->hash == hash;
+		}
+
+		bool	hash_matches(const Node *, size_t, ft::false_type) const
+		{
+			return true;
+		}
+
+		// whether the node holds key, whose hash is hash
+		template<class K>
+		bool	node_matches(const Node *n, size_t hash, const K& key) const
+		{
+			return this->hash_matches(n, hash, cache_hash_type()) && this->_key_equal(key, KeyOfValue()(n->value));
+		}
+
 		void	destroy_node(Node &node)
 		{
 			this->_node_allocator.destroy(static_cast<Node*>(&node));
@@ -639,19 +798,19 @@ template <
 		}
 	};
 
-	template< class K, class U, class H, class KE, class A, bool M, class KOV >
-	bool operator!=( const ft::hash_table<K, U, H, KE, A, M, KOV>& lhs,
-					 const ft::hash_table<K, U, H, KE, A, M, KOV>& rhs )
+	template< class K, class U, class H, class KE, class A, bool M, class KOV, class BP, bool CH >
+	bool operator!=( const ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>& lhs,
+					 const ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>& rhs )
 	{
 		if (lhs.size() != rhs.size())
 			return true;
 
-		typename ft::hash_table<K, U, H, KE, A, M, KOV>::iterator lit1 = lhs.begin();
-		typename ft::hash_table<K, U, H, KE, A, M, KOV>::iterator lit2 = lhs.begin();
+		typename ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>::iterator lit1 = lhs.begin();
+		typename ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>::iterator lit2 = lhs.begin();
 		while (lit1 != lhs.end())
 		{
 			lit2 = lhs.equal_range(*lit1).second;
-			ft::pair<typename ft::hash_table<K, U, H, KE, A, M, KOV>::iterator, typename ft::hash_table<K, U, H, KE, A, M, KOV>::iterator> ritp = rhs.equal_range(*lit1);
+			ft::pair<typename ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>::iterator, typename ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>::iterator> ritp = rhs.equal_range(*lit1);
 			if (ft::distance(ritp.first, ritp.second) != ft::distance(lit1, lit2))
 				return true;
 			if (!ft::is_permutation(lit1, lit2, ritp.first))
@@ -661,16 +820,16 @@ template <
 		return false;
 	}
 
-	template< class K, class U, class H, class KE, class A, bool M, class KOV >
-	bool operator==( const ft::hash_table<K, U, H, KE, A, M, KOV>& lhs,
-					 const ft::hash_table<K, U, H, KE, A, M, KOV>& rhs )
+	template< class K, class U, class H, class KE, class A, bool M, class KOV, class BP, bool CH >
+	bool operator==( const ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>& lhs,
+					 const ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>& rhs )
 	{
 		return !(lhs != rhs);
 	}
 
-	template< class K, class U, class H, class KE, class A, bool M, class KOV >
-	void swap( ft::hash_table<K, U, H, KE, A, M, KOV>& lhs,
-			   ft::hash_table<K, U, H, KE, A, M, KOV>& rhs )
+	template< class K, class U, class H, class KE, class A, bool M, class KOV, class BP, bool CH >
+	void swap( ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>& lhs,
+			   ft::hash_table<K, U, H, KE, A, M, KOV, BP, CH>& rhs )
 	{
 		lhs.swap(rhs);
 	}
@@ -11,11 +11,12 @@ namespace ft {
 			class Key,
 			class T,
 			class Compare = ft::less <Key>,
-			class Allocator = std::allocator <ft::pair<const Key, T> >
+			class Allocator = std::allocator <ft::pair<const Key, T> >,
+			bool OrderStatistics = false
 	>
-	class map : public bst<Key, ft::pair<const Key, T>, Compare, Allocator, false, get_first> {
+	class map : public bst<Key, ft::pair<const Key, T>, Compare, Allocator, false, get_first, OrderStatistics> {
 	private:
-		typedef bst<Key, ft::pair<const Key, T>, Compare, Allocator, false, get_first> bst_type;
+		typedef bst<Key, ft::pair<const Key, T>, Compare, Allocator, false, get_first, OrderStatistics> bst_type;
 	public:
 		typedef T									mapped_type;
 
@@ -41,11 +42,12 @@ namespace ft {
 			class Key,
 			class T,
 			class Compare = ft::less <Key>,
-			class Allocator = std::allocator <ft::pair<const Key, T> >
+			class Allocator = std::allocator <ft::pair<const Key, T> >,
+			bool OrderStatistics = false
 	>
-	class multimap : public bst<Key, ft::pair<const Key, T>, Compare, Allocator, true, get_first> {
+	class multimap : public bst<Key, ft::pair<const Key, T>, Compare, Allocator, true, get_first, OrderStatistics> {
 	private:
-		typedef bst<Key, ft::pair<const Key, T>, Compare, Allocator, true, get_first> bst_type;
+		typedef bst<Key, ft::pair<const Key, T>, Compare, Allocator, true, get_first, OrderStatistics> bst_type;
 	public:
 		typedef Key									key_type;
 		typedef T									mapped_type;
@@ -69,9 +71,11 @@ namespace ft {
 			class Key,
 			class T,
 			class Compare,
-			class Allocator
+			class Allocator,
+			bool OrderStatistics
 	>
-	void	swap(ft::map<Key, T, Compare, Allocator> &lhs, ft::map<Key, T, Compare, Allocator> &rhs)
+	void	swap(ft::map<Key, T, Compare, Allocator, OrderStatistics> &lhs,
+				 ft::map<Key, T, Compare, Allocator, OrderStatistics> &rhs)
 	{
 		rhs.swap(lhs);
 	}
@@ -81,9 +85,11 @@ namespace ft {
 			class Key,
 			class T,
 			class Compare,
-			class Allocator
+			class Allocator,
+			bool OrderStatistics
 	>
-	void	swap(ft::multimap<Key, T, Compare, Allocator> &lhs, ft::multimap<Key, T, Compare, Allocator> &rhs)
+	void	swap(ft::multimap<Key, T, Compare, Allocator, OrderStatistics> &lhs,
+				 ft::multimap<Key, T, Compare, Allocator, OrderStatistics> &rhs)
 	{
 		rhs.swap(lhs);
 	}
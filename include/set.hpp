@@ -9,11 +9,12 @@ namespace ft {
 	template<
 			class Key,
 			class Compare = ft::less<Key>,
-			class Allocator = std::allocator<Key>
+			class Allocator = std::allocator<Key>,
+			bool OrderStatistics = false
 	>
-	class set : public bst<Key, Key, Compare, Allocator> {
+	class set : public bst<Key, Key, Compare, Allocator, false, ft::identity, OrderStatistics> {
 	private:
-		typedef bst<Key, Key, Compare, Allocator> bst_type;
+		typedef bst<Key, Key, Compare, Allocator, false, ft::identity, OrderStatistics> bst_type;
 	public:
 		typedef Key											value_type;
 
@@ -33,11 +34,12 @@ namespace ft {
 	template<
 			class Key,
 			class Compare = ft::less<Key>,
-			class Allocator = std::allocator<Key>
+			class Allocator = std::allocator<Key>,
+			bool OrderStatistics = false
 	>
-	class multiset : public bst<Key, Key, Compare, Allocator, true> {
+	class multiset : public bst<Key, Key, Compare, Allocator, true, ft::identity, OrderStatistics> {
 	private:
-		typedef bst<Key, Key, Compare, Allocator, true> bst_type;
+		typedef bst<Key, Key, Compare, Allocator, true, ft::identity, OrderStatistics> bst_type;
 	public:
 		typedef Key									value_type;
 
@@ -57,20 +59,24 @@ namespace ft {
 
 	template<
 			class Key,
-			class T,
-			class Compare
+			class Compare,
+			class Allocator,
+			bool OrderStatistics
 	>
-	void	swap(ft::set<Key, T, Compare> &lhs, ft::set<Key, T, Compare> &rhs)
+	void	swap(ft::set<Key, Compare, Allocator, OrderStatistics> &lhs,
+				 ft::set<Key, Compare, Allocator, OrderStatistics> &rhs)
 	{
 		rhs.swap(lhs);
 	}
 
 	template<
 			class Key,
-			class T,
-			class Compare
+			class Compare,
+			class Allocator,
+			bool OrderStatistics
 	>
-	void	swap(ft::multiset<Key, T, Compare> &lhs, ft::multiset<Key, T, Compare> &rhs)
+	void	swap(ft::multiset<Key, Compare, Allocator, OrderStatistics> &lhs,
+				 ft::multiset<Key, Compare, Allocator, OrderStatistics> &rhs)
 	{
 		rhs.swap(lhs);
 	}
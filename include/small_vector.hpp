@@ -0,0 +1,61 @@
+#ifndef FT_CONTAINERS_SMALL_VECTOR_HPP
+# define FT_CONTAINERS_SMALL_VECTOR_HPP
+#include <memory>
+#include "vector.hpp"
+
+namespace ft {
+	// vector keeping its first N elements in an inline buffer, the heap is only used once it outgrows it
+	template<
+			class T,
+			size_t N,
+			class Allocator = std::allocator<T>,
+			class Growth = ft::growth_double
+	>
+	class small_vector : public vector<T, Allocator, Growth, ft::vector_inline_storage<T, N> > {
+	private:
+		typedef vector<T, Allocator, Growth, ft::vector_inline_storage<T, N> > vector_type;
+	public:
+		typedef typename vector_type::size_type		size_type;
+		enum {inline_capacity = N};
+
+		small_vector() : vector_type() {}
+
+		explicit small_vector( const Allocator& alloc ) : vector_type(alloc) {}
+
+		explicit small_vector( size_type count,
+					   const T& value = T(),
+					   const Allocator& alloc = Allocator()) : vector_type(count, value, alloc) {}
+
+		template< class InputIt >
+		small_vector( InputIt f, InputIt l, const Allocator& alloc = Allocator()) : vector_type(f, l, alloc) {}
+
+		small_vector( const small_vector& other ) : vector_type(other) {}
+
+#if __cplusplus >= 201103L
+		small_vector( small_vector&& other ) : vector_type(ft::move(other)) {}
+#endif
+
+		small_vector& operator=( const small_vector& other ) {
+			vector_type::operator=(other);
+			return *this;
+		}
+
+#if __cplusplus >= 201103L
+		small_vector& operator=( small_vector&& other ) {
+			vector_type::operator=(ft::move(other));
+			return *this;
+		}
+#endif
+
+		// true while the elements live in the inline buffer
+		bool is_inline() const {return vector_type::is_inline();}
+	};
+
+	template< class T, size_t N, class Alloc, class Growth >
+	void swap( ft::small_vector<T, N, Alloc, Growth>& lhs,
+			   ft::small_vector<T, N, Alloc, Growth>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+#endif
@@ -45,6 +45,9 @@ namespace ft {
 
 	template< class T > struct remove_reference      { typedef T type; };
 	template< class T > struct remove_reference<T&>  { typedef T type; };
+#if __cplusplus >= 201103L
+	template< class T > struct remove_reference<T&&> { typedef T type; };
+#endif
 
 	template<bool B, class T = void>
 	struct enable_if {};
@@ -58,6 +61,68 @@ namespace ft {
 	template<class T, class F>
 	struct conditional<false, T, F> { typedef F type; };
 
+	// true when objects of type T can be copied with a memcpy and don't need to be destroyed
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)
+	template<class T>
+	struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+#else
+	template<class T>
+	struct is_trivially_copyable : public is_integral<T> {};
+	template<class T>
+	struct is_trivially_copyable<T*> : public true_type {};
+	template<>
+	struct is_trivially_copyable<float> : public true_type {};
+	template<>
+	struct is_trivially_copyable<double> : public true_type {};
+	template<>
+	struct is_trivially_copyable<long double> : public true_type {};
+#endif
+
+	// true when destroying objects of type T does nothing
+#if defined(__clang__)
+	template<class T>
+	struct is_trivially_destructible : public integral_constant<bool, __is_trivially_destructible(T)> {};
+#elif defined(__GNUC__)
+	template<class T>
+	struct is_trivially_destructible : public integral_constant<bool, __has_trivial_destructor(T)> {};
+#else
+	template<class T>
+	struct is_trivially_destructible : public is_trivially_copyable<T> {};
+#endif
+
+#if __cplusplus >= 201103L
+	template<class T>
+	T &&declval() noexcept;
+
+	template<class T>
+	struct is_nothrow_move_constructible : public integral_constant<bool, noexcept(T(ft::declval<T>()))> {};
+
+	template<class T>
+	struct is_copy_constructible {
+	private:
+		template<class U, class = decltype(U(ft::declval<const U&>()))>
+		static true_type test(int);
+		template<class>
+		static false_type test(...);
+	public:
+		typedef decltype(test<T>(0)) type;
+		static const bool value = type::value;
+	};
+#endif
+
+	// true when T declares a nested is_transparent type, as the comparators and hashers accepting any key type do
+	template<class T>
+	struct is_transparent {
+	private:
+		template<class U>
+		static char test(typename U::is_transparent *);
+		template<class>
+		static char (&test(...))[2];
+	public:
+		static const bool value = sizeof(test<T>(0)) == 1;
+		typedef integral_constant<bool, value> type;
+	};
+
 	template<class T> struct remove_pointer { typedef T type; };
 	template<class T> struct remove_pointer<T*> { typedef T type; };
 	template<class T> struct remove_pointer<T* const> { typedef T type; };
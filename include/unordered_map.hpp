@@ -9,11 +9,12 @@ namespace ft {
 			class T,
 			class Hash = ft::hash<Key>,
 			class KeyEqual = ft::equal_to<Key>,
-			class Allocator = std::allocator< ft::pair<const Key, T> >
-	> class unordered_map : public hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, false, get_first>
+			class Allocator = std::allocator< ft::pair<const Key, T> >,
+			class BucketPolicy = ft::hash_table_pow2_policy
+	> class unordered_map : public hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, false, get_first, BucketPolicy>
 	{
 	private:
-		typedef hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, false, get_first> hash_table_type;
+		typedef hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, false, get_first, BucketPolicy> hash_table_type;
 	public:
 		typedef T									mapped_type;
 
@@ -50,11 +51,12 @@ namespace ft {
 			class T,
 			class Hash = ft::hash<Key>,
 			class KeyEqual = ft::equal_to<Key>,
-			class Allocator = std::allocator< ft::pair<const Key, T> >
+			class Allocator = std::allocator< ft::pair<const Key, T> >,
+			class BucketPolicy = ft::hash_table_pow2_policy
 	>
-	class unordered_multimap : public hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, true, get_first> {
+	class unordered_multimap : public hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, true, get_first, BucketPolicy> {
 	private:
-		typedef hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, true, get_first> hash_table_type;
+		typedef hash_table<Key, ft::pair<const Key, T>, Hash, KeyEqual, Allocator, true, get_first, BucketPolicy> hash_table_type;
 	public:
 		typedef T									mapped_type;
 
@@ -84,9 +86,10 @@ namespace ft {
 			class T,
 			class Hash,
 			class KeyEqual,
-			class Allocator
+			class Allocator,
+			class BucketPolicy
 	>
-	void	swap(ft::unordered_map<Key, T, Hash, KeyEqual, Allocator> &lhs, ft::unordered_map<Key, T, Hash, KeyEqual, Allocator> &rhs)
+	void	swap(ft::unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy> &lhs, ft::unordered_map<Key, T, Hash, KeyEqual, Allocator, BucketPolicy> &rhs)
 	{
 		rhs.swap(lhs);
 	}
@@ -97,9 +100,10 @@ namespace ft {
 			class T,
 			class Hash,
 			class KeyEqual,
-			class Allocator
+			class Allocator,
+			class BucketPolicy
 	>
-	void	swap(ft::unordered_multimap<Key, T, Hash, KeyEqual, Allocator> &lhs, ft::unordered_multimap<Key, T, Hash, KeyEqual, Allocator> &rhs)
+	void	swap(ft::unordered_multimap<Key, T, Hash, KeyEqual, Allocator, BucketPolicy> &lhs, ft::unordered_multimap<Key, T, Hash, KeyEqual, Allocator, BucketPolicy> &rhs)
 	{
 		rhs.swap(lhs);
 	}
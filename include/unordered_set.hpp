@@ -8,11 +8,12 @@ namespace ft {
 			class Key,
 			class Hash = ft::hash<Key>,
 			class KeyEqual = ft::equal_to<Key>,
-			class Allocator = std::allocator<Key>
-	> class unordered_set : public hash_table<Key, Key, Hash, KeyEqual, Allocator, false, ft::identity>
+			class Allocator = std::allocator<Key>,
+			class BucketPolicy = ft::hash_table_pow2_policy
+	> class unordered_set : public hash_table<Key, Key, Hash, KeyEqual, Allocator, false, ft::identity, BucketPolicy>
 	{
 	private:
-		typedef hash_table<Key, Key, Hash, KeyEqual, Allocator, false, ft::identity> hash_table_type;
+		typedef hash_table<Key, Key, Hash, KeyEqual, Allocator, false, ft::identity, BucketPolicy> hash_table_type;
 	public:
 		typedef Key											value_type;
 
@@ -41,11 +42,12 @@ namespace ft {
 			class Key,
 			class Hash = ft::hash<Key>,
 			class KeyEqual = ft::equal_to<Key>,
-			class Allocator = std::allocator<Key>
+			class Allocator = std::allocator<Key>,
+			class BucketPolicy = ft::hash_table_pow2_policy
 	>
-	class unordered_multiset : public hash_table<Key, Key, Hash, KeyEqual, Allocator, true, ft::identity> {
+	class unordered_multiset : public hash_table<Key, Key, Hash, KeyEqual, Allocator, true, ft::identity, BucketPolicy> {
 	private:
-		typedef hash_table<Key, Key, Hash, KeyEqual, Allocator, true, ft::identity> hash_table_type;
+		typedef hash_table<Key, Key, Hash, KeyEqual, Allocator, true, ft::identity, BucketPolicy> hash_table_type;
 	public:
 		typedef Key									value_type;
 
@@ -75,9 +77,10 @@ namespace ft {
 			class Key,
 			class Hash,
 			class KeyEqual,
-			class Allocator
+			class Allocator,
+			class BucketPolicy
 	>
-	void	swap(ft::unordered_set<Key, Hash, KeyEqual, Allocator> &lhs, ft::unordered_set<Key, Hash, KeyEqual, Allocator> &rhs)
+	void	swap(ft::unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy> &lhs, ft::unordered_set<Key, Hash, KeyEqual, Allocator, BucketPolicy> &rhs)
 	{
 		rhs.swap(lhs);
 	}
@@ -87,9 +90,10 @@ namespace ft {
 			class Key,
 			class Hash,
 			class KeyEqual,
-			class Allocator
+			class Allocator,
+			class BucketPolicy
 	>
-	void	swap(ft::unordered_multiset<Key, Hash, KeyEqual, Allocator> &lhs, ft::unordered_multiset<Key, Hash, KeyEqual, Allocator> &rhs)
+	void	swap(ft::unordered_multiset<Key, Hash, KeyEqual, Allocator, BucketPolicy> &lhs, ft::unordered_multiset<Key, Hash, KeyEqual, Allocator, BucketPolicy> &rhs)
 	{
 		rhs.swap(lhs);
 	}
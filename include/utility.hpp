@@ -1,8 +1,47 @@
 #ifndef FT_CONTAINERS_UTILITY_HPP
 #define FT_CONTAINERS_UTILITY_HPP
+#include "type_traits.hpp"
 
 namespace ft
 {
+#if __cplusplus >= 201103L
+	template<class T>
+	typename remove_reference<T>::type &&move(T &&t) noexcept
+	{
+		return static_cast<typename remove_reference<T>::type &&>(t);
+	}
+
+	template<class T>
+	T &&forward(typename remove_reference<T>::type &t) noexcept
+	{
+		return static_cast<T &&>(t);
+	}
+
+	template<class T>
+	T &&forward(typename remove_reference<T>::type &&t) noexcept
+	{
+		return static_cast<T &&>(t);
+	}
+
+	// move unless it could throw and a copy is possible
+	template<class T>
+	typename conditional<!is_nothrow_move_constructible<T>::value && is_copy_constructible<T>::value, const T &, T &&>::type
+	move_if_noexcept(T &t) noexcept
+	{
+		return ft::move(t);
+	}
+#else
+	// without rvalue references moving is copying
+	template<class T>
+	T &move(T &t) { return t; }
+
+	template<class T>
+	const T &move(const T &t) { return t; }
+
+	template<class T>
+	const T &move_if_noexcept(const T &t) { return t; }
+#endif
+
 	template<class T1,class T2>
 	struct pair
 	{
@@ -15,12 +54,23 @@ namespace ft
 		template< class U1, class U2 >
 		pair( const pair<U1, U2>& p ) : first(p.first), second(p.second) {}
 		pair( const pair& p ) : first(p.first), second(p.second) {};
-//		pair& operator=( const pair& other )
-//		{
-//			this->first = other.first;
-//			this->second = other.second;
-//			return *this;
-//		}
+		pair& operator=( const pair& other )
+		{
+			this->first = other.first;
+			this->second = other.second;
+			return *this;
+		}
+#if __cplusplus >= 201103L
+		// the copy ones above are user declared, these would not be implicit
+		pair( pair&& p ) noexcept(is_nothrow_move_constructible<T1>::value && is_nothrow_move_constructible<T2>::value)
+			: first(ft::move(p.first)), second(ft::move(p.second)) {}
+		pair& operator=( pair&& other ) noexcept(noexcept(ft::declval<T1 &>() = ft::declval<T1>()) && noexcept(ft::declval<T2 &>() = ft::declval<T2>()))
+		{
+			this->first = ft::move(other.first);
+			this->second = ft::move(other.second);
+			return *this;
+		}
+#endif
 
 	};
 
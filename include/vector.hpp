@@ -4,17 +4,79 @@
 #include <stdexcept.hpp>
 #include <iostream>
 #include "algorithm.hpp"
-//#include "utility.hpp"
+#include "utility.hpp"
 #include "functional.hpp"
 #include "iterator.hpp"
 #include "type_traits.hpp"
 
 namespace ft {
+	// growth policies of ft::vector, next() returns the capacity to allocate when
+	// capacity elements of element_size bytes are not enough to hold required elements
+	struct growth_double {
+		static size_t next(size_t capacity, size_t required, size_t)
+		{
+			return ft::max(required, capacity * 2);
+		}
+	};
+
+	struct growth_one_and_half {
+		static size_t next(size_t capacity, size_t required, size_t)
+		{
+			return ft::max(required, capacity + capacity / 2);
+		}
+	};
+
+	// no slack at all, every growth reallocates
+	struct growth_exact {
+		static size_t next(size_t, size_t required, size_t)
+		{
+			return required;
+		}
+	};
+
+	// grow by 1.5 and round buffers bigger than a page up to a whole number of pages
+	template<size_t PageSize = 4096>
+	struct growth_page {
+		static size_t next(size_t capacity, size_t required, size_t element_size)
+		{
+			size_t bytes = ft::max(required, capacity + capacity / 2) * element_size;
+			if (bytes > PageSize)
+				bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+			return ft::max(required, bytes / element_size);
+		}
+	};
+
+	// storage policies of ft::vector, the buffer holding the first elements without allocating
+
+	// none, everything is allocated
+	template<class T>
+	struct vector_heap_storage {
+		enum {inline_capacity = 0};
+		T *inline_data() {return NULL;}
+		const T *inline_data() const {return NULL;}
+	};
+
+	// N elements inside the vector itself, see ft::small_vector
+	template<class T, size_t N>
+	struct vector_inline_storage {
+		enum {inline_capacity = N};
+		T *inline_data() {return reinterpret_cast<T *>(this->storage);}
+		const T *inline_data() const {return reinterpret_cast<const T *>(this->storage);}
+	private:
+		char	storage[N * sizeof(T)] __attribute__((aligned(__alignof__(T))));
+	};
+
+	// an empty inline buffer is a vector_heap_storage
+	template<class T>
+	struct vector_inline_storage<T, 0>;
+
 	template<
 			class T,
-			class Allocator = std::allocator<T>
+			class Allocator = std::allocator<T>,
+			class Growth = ft::growth_double,
+			class Storage = ft::vector_heap_storage<T>
 	>
-	class vector {
+	class vector : protected Storage {
 	public:
 		typedef T										value_type;
 		typedef Allocator								allocator_type;
@@ -34,26 +96,33 @@ namespace ft {
 		size_type		_capacity;
 		allocator_type	allocator;
 	public:
-		vector() : data(NULL), _size(0), _capacity(0), allocator() {}
+		vector() : data(this->inline_data()), _size(0), _capacity(Storage::inline_capacity), allocator() {}
 
-		explicit vector( const Allocator& alloc ) : data(NULL), _size(0), _capacity(0), allocator(alloc) {}
+		explicit vector( const Allocator& alloc ) : data(this->inline_data()), _size(0), _capacity(Storage::inline_capacity), allocator(alloc) {}
 		
 		explicit vector( size_type count,
 					   const T& value = T(),
-					   const Allocator& alloc = Allocator()) : data(NULL), _size(0), _capacity(0), allocator(alloc) {
+					   const Allocator& alloc = Allocator()) : data(this->inline_data()), _size(0), _capacity(Storage::inline_capacity), allocator(alloc) {
 			this->insert(this->end(), count, value);
 		}
 
 		template< class InputIt >
-		vector( InputIt f, InputIt l, const Allocator& alloc = Allocator()) : data(NULL), _size(0), _capacity(0), allocator(alloc)
+		vector( InputIt f, InputIt l, const Allocator& alloc = Allocator()) : data(this->inline_data()), _size(0), _capacity(Storage::inline_capacity), allocator(alloc)
 		{
 			this->insert(this->end(), f, l);
 		}
 
-		vector( const vector& other ) : data(NULL), _size(0), _capacity(0), allocator(other.allocator) {
+		vector( const vector& other ) : Storage(), data(this->inline_data()), _size(0), _capacity(Storage::inline_capacity), allocator(other.allocator) {
 			this->insert(this->end(), other.begin(), other.end());
 		}
 
+#if __cplusplus >= 201103L
+		// inline elements can only be moved one by one
+		vector( vector&& other ) noexcept(Storage::inline_capacity == 0) : Storage(), data(this->inline_data()), _size(0), _capacity(Storage::inline_capacity), allocator(ft::move(other.allocator)) {
+			this->steal(other);
+		}
+#endif
+
 		~vector()
 		{
 			this->clear();
@@ -65,6 +134,16 @@ namespace ft {
 			return *this;
 		}
 
+#if __cplusplus >= 201103L
+		vector& operator=( vector&& other ) noexcept(Storage::inline_capacity == 0) {
+			this->clear();
+			this->free();
+			this->allocator = ft::move(other.allocator);
+			this->steal(other);
+			return *this;
+		}
+#endif
+
 		void assign( size_type count, const T& value ) {
 			this->clear();
 			this->insert(this->begin(), count, value);
@@ -130,9 +209,7 @@ namespace ft {
 			if (new_cap <= this->_capacity)
 				return;
 			pointer tmp = this->allocator.allocate(new_cap);
-			for (size_type i = 0; i < this->_size; i++)
-				this->allocator.construct(tmp + i, this->data[i]);
-			this->destroy(this->data, this->_size);
+			this->relocate(tmp, this->data, this->_size, typename ft::is_trivially_copyable<T>::type());
 			this->free();
 			this->data = tmp;
 			this->_capacity = new_cap;
@@ -151,6 +228,30 @@ namespace ft {
 			return this->insert(pos, 1, value, ft::true_type());
 		}
 
+#if __cplusplus >= 201103L
+		iterator insert( const_iterator pos, T&& value )
+		{
+			return this->emplace(pos, ft::move(value));
+		}
+
+		template< class... Args >
+		iterator emplace( const_iterator pos, Args&&... args )
+		{
+			size_type offset = pos - this->data;
+			if (offset == this->_size)
+			{
+				this->emplace_back(ft::forward<Args>(args)...);
+				return this->data + offset;
+			}
+			// built before shifting since args may refer to elements of this vector
+			T tmp(ft::forward<Args>(args)...);
+			this->make_room((pointer)pos, 1);
+			this->data[offset] = ft::move(tmp);
+			this->_size++;
+			return this->data + offset;
+		}
+#endif
+
 		void insert( const_iterator pos, size_type count, const T& value)
 		{
 			this->insert(pos, count, value, ft::true_type());
@@ -158,34 +259,26 @@ namespace ft {
 	private:
 		iterator insert( const_iterator pos, size_type count, const T& value, ft::true_type)
 		{
-			size_type offset = pos - this->data;
-			this->make_room((pointer)pos, count);
-			pos = this->data + offset;
-			for (size_type i = 0; i < count; i++)
+			// an element of this vector would be shifted or freed by make_room before being read
+			if (&value >= this->data && &value < this->data + this->_size)
 			{
-				if (pos + i >= this->data + this->_size)
-					this->construct((pointer)pos + i, 1, value);
-				else
-					((pointer)pos)[i] = value;
+				T tmp(value);
+				return this->insert(pos, generator_it<const T&>(tmp), generator_it<const T&>(count, tmp), ft::forward_iterator_tag());
 			}
-			this->_size += count;
-			return (iterator)pos;
+			return this->insert(pos, generator_it<const T&>(value), generator_it<const T&>(count, value), ft::forward_iterator_tag());
 		}
 
-		template< class It >
-		iterator insert( const_iterator pos, It f, It l, ft::random_access_iterator_tag)
+		template< class ForwardIt >
+		iterator insert( const_iterator pos, ForwardIt f, ForwardIt l, ft::forward_iterator_tag)
 		{
 			size_type offset = pos - this->data;
-			this->make_room((pointer)pos, l - f);
+			size_type count = ft::distance(f, l);
+			this->make_room((pointer)pos, count);
 			pointer p = this->data + offset;
-			for (size_type i = 0; i + f < l; i++)
-			{
-				if (p + i >= this->data + this->_size)
-					this->construct(p + i, 1, f[i]);
-				else
-					p[i] = f[i];
-			}
-			this->_size += l - f;
+			// the first new elements overwrite the ones that were shifted, the others land past the end
+			size_type assigned = ft::min(count, this->_size - offset);
+			this->construct_n(p + assigned, this->assign_n(p, f, assigned), count - assigned);
+			this->_size += count;
 			return p;
 		}
 
@@ -218,13 +311,35 @@ namespace ft {
 
 		iterator erase( iterator first, iterator last )
 		{
-			this->move(first, last, this->end() - last, false);
-			this->destroy(this->end() - (last - first), last - first);
-			this->_size -= last - first;
+			size_type count = last - first;
+			this->shift_left(first, last, this->end() - last, typename ft::is_trivially_copyable<T>::type());
+			this->destroy(this->end() - count, count);
+			this->_size -= count;
 			return first;
 		}
 
-		void push_back( const T& value ) {this->insert(const_iterator(this->end()), value);}
+#if __cplusplus >= 201103L
+		void push_back( const T& value ) {this->emplace_back(value);}
+
+		void push_back( T&& value ) {this->emplace_back(ft::move(value));}
+
+		template< class... Args >
+		void emplace_back( Args&&... args )
+		{
+			if (this->_size == this->_capacity)
+				return this->realloc_append(ft::forward<Args>(args)...);
+			this->allocator.construct(this->data + this->_size, ft::forward<Args>(args)...);
+			this->_size++;
+		}
+#else
+		void push_back( const T& value )
+		{
+			if (this->_size == this->_capacity)
+				return this->realloc_append(value);
+			this->allocator.construct(this->data + this->_size, value);
+			this->_size++;
+		}
+#endif
 
 		void pop_back() {this->erase(this->end() - 1);}
 
@@ -236,99 +351,182 @@ namespace ft {
 				this->erase(this->begin() + count, this->end());
 		}
 
+		// heap buffers are exchanged, inline elements have to be relocated
 		void swap( vector& other )
 		{
-			ft::swap(this->data, other.data);
+			if (!this->is_inline() && !other.is_inline())
+			{
+				ft::swap(this->data, other.data);
+				ft::swap(this->_size, other._size);
+				ft::swap(this->_capacity, other._capacity);
+			}
+			else
+			{
+				vector tmp(this->allocator);
+				tmp.steal(*this);
+				this->steal(other);
+				other.steal(tmp);
+			}
 			ft::swap(this->allocator, other.allocator);
-			ft::swap(this->_size, other._size);
-			ft::swap(this->_capacity, other._capacity);
 		}
 
+	protected:
+		// true while the elements live in the inline buffer, never with vector_heap_storage
+		bool is_inline() const {return Storage::inline_capacity != 0 && this->data == this->inline_data();}
+
 	private:
+		// take the elements of other, this must be empty with no heap buffer, other is left the same way
+		void steal(vector& other)
+		{
+			if (other.is_inline())
+			{
+				this->relocate(this->data, other.data, other._size, typename ft::is_trivially_copyable<T>::type());
+				this->_size = other._size;
+			}
+			else
+			{
+				this->data = other.data;
+				this->_size = other._size;
+				this->_capacity = other._capacity;
+				other.data = other.inline_data();
+				other._capacity = Storage::inline_capacity;
+			}
+			other._size = 0;
+		}
 		void destroy(pointer p, size_type n) {
 			for (size_type i = 0; i < n; i++)
 				this->allocator.destroy(p + i);
 		}
-		void construct(pointer p, size_type n, const T& value)
+		template< class It >
+		It construct_n(pointer dst, It f, size_type n)
+		{
+			for (size_type i = 0; i < n; i++, ++f)
+				this->allocator.construct(dst + i, *f);
+			return f;
+		}
+		template< class It >
+		It assign_n(pointer dst, It f, size_type n)
+		{
+			for (size_type i = 0; i < n; i++, ++f)
+				dst[i] = *f;
+			return f;
+		}
+		// move n elements to the uninitialized storage dst, src is left uninitialized
+		void relocate(pointer dst, pointer src, size_type n, ft::true_type)
+		{
+			if (n)
+				__builtin_memcpy(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+		}
+		void relocate(pointer dst, pointer src, size_type n, ft::false_type)
 		{
 			for (size_type i = 0; i < n; i++)
-				this->allocator.construct(p + i, value);
+				this->allocator.construct(dst + i, ft::move_if_noexcept(src[i]));
+			this->destroy(src, n);
 		}
-		void make_room(pointer p, size_type count)
+		// move the n elements starting at p count slots to the right, the slots past the end get constructed
+		void shift_right(pointer p, size_type n, size_type count, ft::true_type)
 		{
-			size_t offset = p - this->data;
-			this->reserve_for(count);
-			p = this->data + offset;
-			this->move(p + count, p, (this->data + this->_size) - p);
+			if (n && count)
+				__builtin_memmove(static_cast<void *>(p + count), static_cast<const void *>(p), n * sizeof(T));
 		}
-		void move(pointer dst, pointer src, size_type count, bool destroy = false)
+		void shift_right(pointer p, size_type n, size_type count, ft::false_type)
 		{
-			if (dst < src)
-				for (size_type i = 0; i < count; i++)
-					this->move_one(dst + i, src + i, destroy);
-			else
-				for (size_type i = count; i > 0; i--)
-					this->move_one(dst + i - 1, src + i - 1, destroy);
+			// an empty insert would move the elements onto themselves
+			if (!count)
+				return;
+			pointer end = p + n;
+			size_type constructed = ft::min(n, count);
+			for (size_type i = 0; i < constructed; i++)
+				this->allocator.construct(end + count - constructed + i, ft::move((end - constructed)[i]));
+			// the remaining ones overwrite live elements, from the back so none is overwritten before being moved
+			for (pointer src = end - constructed, dst = end + count - constructed; src != p;)
+				*--dst = ft::move(*--src);
 		}
-		void move_one(pointer dst, pointer src, bool destroy = false)
+		// move the n elements starting at src to dst (dst < src), the elements left behind are still alive
+		void shift_left(pointer dst, pointer src, size_type n, ft::true_type)
 		{
-			if (dst >= this->data + this->_size)
-			{
-				this->allocator.construct(dst, *src);
-				if (destroy)
-					this->allocator.destroy(src);
-			}
-			else
-			{
-				*dst = *src;
-				if (destroy)
-					this->allocator.destroy(src);
-			}
+			if (n && dst != src)
+				__builtin_memmove(static_cast<void *>(dst), static_cast<const void *>(src), n * sizeof(T));
+		}
+		void shift_left(pointer dst, pointer src, size_type n, ft::false_type)
+		{
+			// an empty erase would move the elements onto themselves
+			if (dst == src)
+				return;
+			for (size_type i = 0; i < n; i++)
+				dst[i] = ft::move(src[i]);
 		}
+		void make_room(pointer p, size_type count)
+		{
+			size_t offset = p - this->data;
+			this->reserve_for(count);
+			p = this->data + offset;
+			this->shift_right(p, (this->data + this->_size) - p, count, typename ft::is_trivially_copyable<T>::type());
+		}
+		// the inline buffer is never deallocated
 		void free() {
-			this->allocator.deallocate(this->data, this->_capacity);
-			this->data = NULL;
-			this->_capacity = 0;
+			if (!this->is_inline())
+				this->allocator.deallocate(this->data, this->_capacity);
+			this->data = this->inline_data();
+			this->_capacity = Storage::inline_capacity;
 		}
 		void reserve_for(size_type n)
 		{
-			size_type new_cap = this->_capacity;
-			if (!new_cap)
-				new_cap = 1;
-			while (this->_size + n > new_cap)
-				new_cap *= 2;
-			this->reserve(new_cap);
+			if (this->_size + n > this->_capacity)
+				this->reserve(Growth::next(this->_capacity, this->_size + n, sizeof(T)));
+		}
+		// append to a full vector, the new element is built before the old ones are relocated
+		// since it may be built from one of them
+#if __cplusplus >= 201103L
+		template< class... Args >
+		void realloc_append( Args&&... args )
+#else
+		void realloc_append( const T& value )
+#endif
+		{
+			size_type new_cap = Growth::next(this->_capacity, this->_size + 1, sizeof(T));
+			pointer tmp = this->allocator.allocate(new_cap);
+#if __cplusplus >= 201103L
+			this->allocator.construct(tmp + this->_size, ft::forward<Args>(args)...);
+#else
+			this->allocator.construct(tmp + this->_size, value);
+#endif
+			this->relocate(tmp, this->data, this->_size, typename ft::is_trivially_copyable<T>::type());
+			this->free();
+			this->data = tmp;
+			this->_capacity = new_cap;
+			this->_size++;
 		}
 	};
 
-	template <class T, class Allocator>
-	bool operator==(const vector<T, Allocator> &lhs, const vector<T, Allocator> &rhs) {
-		return ((lhs.size() == rhs.size()) && ft::equal<typename vector<T, Allocator>::const_iterator, typename vector<T, Allocator>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin()));
+	template <class T, class Allocator, class Growth, class Storage>
+	bool operator==(const vector<T, Allocator, Growth, Storage> &lhs, const vector<T, Allocator, Growth, Storage> &rhs) {
+		return ((lhs.size() == rhs.size()) && ft::equal<typename vector<T, Allocator, Growth, Storage>::const_iterator, typename vector<T, Allocator, Growth, Storage>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin()));
 	}
-	template <class T, class Allocator>
- 	bool operator!=(const vector<T, Allocator> &lhs, const vector<T, Allocator> &rhs) {
+	template <class T, class Allocator, class Growth, class Storage>
+ 	bool operator!=(const vector<T, Allocator, Growth, Storage> &lhs, const vector<T, Allocator, Growth, Storage> &rhs) {
 		return (!(lhs == rhs));
 	}
-	template <class T, class Allocator>
- 	bool operator<(const vector<T, Allocator> &lhs, const vector<T, Allocator> &rhs) {
-		return (ft::lexicographical_compare<typename vector<T, Allocator>::const_iterator, typename vector<T, Allocator>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	template <class T, class Allocator, class Growth, class Storage>
+ 	bool operator<(const vector<T, Allocator, Growth, Storage> &lhs, const vector<T, Allocator, Growth, Storage> &rhs) {
+		return (ft::lexicographical_compare<typename vector<T, Allocator, Growth, Storage>::const_iterator, typename vector<T, Allocator, Growth, Storage>::const_iterator>(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
-	template <class T, class Allocator>
-	bool operator<=(const vector<T, Allocator> &lhs, const vector<T, Allocator> &rhs) {
+	template <class T, class Allocator, class Growth, class Storage>
+	bool operator<=(const vector<T, Allocator, Growth, Storage> &lhs, const vector<T, Allocator, Growth, Storage> &rhs) {
 		return (!(rhs < lhs));
 	}
-	template <class T, class Allocator>
-	bool operator>(const vector<T, Allocator> &lhs, const vector<T, Allocator> &rhs) {
+	template <class T, class Allocator, class Growth, class Storage>
+	bool operator>(const vector<T, Allocator, Growth, Storage> &lhs, const vector<T, Allocator, Growth, Storage> &rhs) {
 		return (rhs < lhs);
 	}
-	template <class T, class Allocator>
-	bool operator>=(const vector<T, Allocator> &lhs, const vector<T, Allocator> &rhs) {
+	template <class T, class Allocator, class Growth, class Storage>
+	bool operator>=(const vector<T, Allocator, Growth, Storage> &lhs, const vector<T, Allocator, Growth, Storage> &rhs) {
 		return (!(lhs < rhs));
 	}
 
-	template< class T, class Alloc >
-	void swap( ft::vector<T, Alloc>& lhs,
-			   ft::vector<T, Alloc>& rhs)
+	template< class T, class Alloc, class Growth, class Storage >
+	void swap( ft::vector<T, Alloc, Growth, Storage>& lhs,
+			   ft::vector<T, Alloc, Growth, Storage>& rhs)
 	{
 		lhs.swap(rhs);
 	}
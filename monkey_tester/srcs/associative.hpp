@@ -79,6 +79,44 @@ namespace associative
 		a.insert(input_iterator<typename std::vector<typename C::value_type>::iterator>(range.begin()), input_iterator<typename std::vector<typename C::value_type>::iterator>(range.end()));
 	}
 
+	// the mapped values given by monkey::get_value are all the same, these ones show where equal keys go
+	template <class C>
+	typename C::value_type	get_mapped_value()
+	{
+		typename C::key_type key((monkey::get_value()));
+		typename C::mapped_type mapped((monkey::get_value()));
+		return typename C::value_type(key, mapped);
+	}
+
+	template <class C>
+	void	insert_hint_mapped(C &a, C &)
+	{
+		FNAME
+		typename C::value_type value = get_mapped_value<C>();
+		typename C::iterator hint = monkey::get_random_it(a.begin(), a.end());
+		std::cout << "a.insert(hint, value) with hint: ";
+		monkey::print_it(a, hint);
+		std::cout << " and value: [" << value << "]" << std::endl;
+		typename C::iterator ret = a.insert(hint, value);
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	template <class C>
+	void	insert_range_mapped(C &a, C &)
+	{
+		FNAME
+		std::vector<typename C::value_type> range;
+		for (int size = rand() % BASE_SIZE; size > 0; size--)
+			range.push_back(get_mapped_value<C>());
+		std::cout << "a.insert(range) with range: ";
+		monkey::print_range(range.begin(), range.end());
+		std::cout << std::endl;
+
+		a.insert(input_iterator<typename std::vector<typename C::value_type>::iterator>(range.begin()), input_iterator<typename std::vector<typename C::value_type>::iterator>(range.end()));
+	}
+
 	template <class C>
 	void	erase_value(C &a, C &)
 	{
@@ -96,7 +134,8 @@ namespace associative
 		FNAME
 		if (a.size() == 0)
 			return;
-		typename C::iterator it = monkey::get_random_it(a.begin(), --a.end());
+		typename C::iterator last = a.end();
+		typename C::iterator it = monkey::get_random_it(a.begin(), --last);
 
 		std::cout << "a.erase(it) with it = ";
 		monkey::print_it(a, it);
@@ -26,7 +26,7 @@ monkey::function_table<C> get_table () \
 	return monkey::function_table<C>(array, sizeof(array) / sizeof (*array));\
 }
 
-#if defined(TEST_MAP) || defined(TEST_SET) || defined(TEST_MULTIMAP) || defined (TEST_MULTISET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET)
+#if defined(TEST_MAP) || defined(TEST_SET) || defined(TEST_MULTIMAP) || defined (TEST_MULTISET) || defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS) || defined(TEST_MAP_TRANSPARENT) || defined(TEST_FLAT_MAP) || defined(TEST_FLAT_SET) || defined(TEST_FLAT_MULTIMAP) || defined (TEST_FLAT_MULTISET) || defined(TEST_BTREE_MAP) || defined(TEST_BTREE_SET) || defined(TEST_BTREE_MULTIMAP) || defined (TEST_BTREE_MULTISET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET) || defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET) || defined(TEST_UNORDERED_MAP_PRIME) || defined(TEST_UNORDERED_MAP_TRANSPARENT)
 # ifdef TEST_FT
 #  include "utility.hpp"
 # else
@@ -39,10 +39,38 @@ std::ostream &operator<<(std::ostream &s, NAMESPACE::pair<A, B> p) {
 }
 #endif
 
-#if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET)
+#ifdef TEST_MAP_TRANSPARENT
+# ifdef TEST_FT
+#  include "functional.hpp"
+# else
+#  include <functional>
+# endif
+// less has no state, any two of them compare equal (for associative::key_comp)
+template<typename T>
+bool operator==(const NAMESPACE::less<T> &, const NAMESPACE::less<T> &) {return true;}
+#endif
+
+#if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET) || defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET) || defined(TEST_UNORDERED_MAP_PRIME) || defined(TEST_UNORDERED_MAP_TRANSPARENT) \
+	|| defined(TEST_UNORDERED_SET_DOUBLE) || defined(TEST_UNORDERED_SET_POINTER)
 #define UNSTABLE
 #endif
 
+#ifdef TEST_UNORDERED_SET_POINTER
+namespace monkey {
+	// the pointers tested, adjacent ints
+	inline int *cells()
+	{
+		static int array[64];
+		return array;
+	}
+}
+
+// print a pointer as its index in the cells, so that both binaries print the same
+std::ostream &operator<<(std::ostream &s, const int *p) {
+	return s << "cell " << p - monkey::cells();
+}
+#endif
+
 namespace monkey {
 
 	// this class return a random value of the desired type (can be used like a function)
@@ -81,7 +109,22 @@ namespace monkey {
 				return (ret);
 			}
 		}
-#if defined(TEST_MAP) || defined(TEST_SET) || defined(TEST_MULTIMAP) || defined (TEST_MULTISET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET)
+#ifdef TEST_UNORDERED_SET_DOUBLE
+		operator double()
+		{
+			if (!(std::rand() % 3)) // return a zero of either sign, equal but not the same bits
+				return ((std::rand() % 2) ? 0.0 : -0.0);
+			else // return a completely random value
+				return (std::rand() / 1024.0);
+		}
+#endif
+#ifdef TEST_UNORDERED_SET_POINTER
+		operator int*()
+		{
+			return (monkey::cells() + std::rand() % 64);
+		}
+#endif
+#if defined(TEST_MAP) || defined(TEST_SET) || defined(TEST_MULTIMAP) || defined (TEST_MULTISET) || defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS) || defined(TEST_MAP_TRANSPARENT) || defined(TEST_FLAT_MAP) || defined(TEST_FLAT_SET) || defined(TEST_FLAT_MULTIMAP) || defined (TEST_FLAT_MULTISET) || defined(TEST_BTREE_MAP) || defined(TEST_BTREE_SET) || defined(TEST_BTREE_MULTIMAP) || defined (TEST_BTREE_MULTISET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTIMAP) || defined (TEST_UNORDERED_MULTISET) || defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET) || defined(TEST_UNORDERED_MAP_PRIME) || defined(TEST_UNORDERED_MAP_TRANSPARENT)
 		template <typename L, typename R>
 		operator NAMESPACE::pair<L, R>()
 		{
@@ -1,20 +1,49 @@
+// the variants of a container built with other flags (see the Makefile) run its tests
+#if defined(TEST_FLAT_HASH_MAP_PORTABLE) || defined(TEST_FLAT_HASH_MAP_AVX2)
+# define TEST_FLAT_HASH_MAP
+#endif
+#if defined(TEST_VECTOR_CPP11)
+# define TEST_VECTOR
+#endif
+
 #ifdef TEST_FT
 # define NAMESPACE ft
-# if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTIMAP)
+# if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTIMAP) || defined(TEST_UNORDERED_MAP_PRIME) || defined(TEST_UNORDERED_MAP_TRANSPARENT)
 #  include "unordered_map.hpp"
 # endif
-# if defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTISET)
+# if defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTISET) || defined(TEST_UNORDERED_SET_DOUBLE) || defined(TEST_UNORDERED_SET_POINTER)
 #  include "unordered_set.hpp"
 # endif
-# if defined(TEST_MAP) || defined(TEST_MULTIMAP)
+# ifdef TEST_FLAT_HASH_MAP
+#  include "flat_hash_map.hpp"
+# endif
+# ifdef TEST_FLAT_HASH_SET
+#  include "flat_hash_set.hpp"
+# endif
+# if defined(TEST_MAP) || defined(TEST_MULTIMAP) || defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS) || defined(TEST_MAP_TRANSPARENT)
 #  include "map.hpp"
 # endif
 # if defined(TEST_SET) || defined(TEST_MULTISET)
 #  include "set.hpp"
 # endif
+# if defined(TEST_FLAT_MAP) || defined(TEST_FLAT_MULTIMAP)
+#  include "flat_map.hpp"
+# endif
+# if defined(TEST_FLAT_SET) || defined(TEST_FLAT_MULTISET)
+#  include "flat_set.hpp"
+# endif
+# if defined(TEST_BTREE_MAP) || defined(TEST_BTREE_MULTIMAP)
+#  include "btree_map.hpp"
+# endif
+# if defined(TEST_BTREE_SET) || defined(TEST_BTREE_MULTISET)
+#  include "btree_set.hpp"
+# endif
 # ifdef TEST_VECTOR
 #  include "vector.hpp"
 # endif
+# ifdef TEST_SMALL_VECTOR
+#  include "small_vector.hpp"
+# endif
 # ifdef TEST_STACK
 #  include "stack.hpp"
 # endif
@@ -35,21 +64,59 @@
 # endif
 #elif defined(TEST_STD)
 # define NAMESPACE std
-# if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTIMAP)
+# if defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTIMAP) || defined(TEST_UNORDERED_MAP_PRIME) || defined(TEST_UNORDERED_MAP_TRANSPARENT)
+#  include <unordered_map>
+# endif
+# if defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTISET) || defined(TEST_UNORDERED_SET_DOUBLE) || defined(TEST_UNORDERED_SET_POINTER)
+#  include <unordered_set>
+# endif
+# ifdef TEST_FLAT_HASH_MAP
+#  warning no flat_hash_map in stl
 #  include <unordered_map>
+#define flat_hash_map unordered_map
 # endif
-# if defined(TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MULTISET)
+# ifdef TEST_FLAT_HASH_SET
+#  warning no flat_hash_set in stl
 #  include <unordered_set>
+#define flat_hash_set unordered_set
 # endif
-# if defined(TEST_MAP) || defined(TEST_MULTIMAP)
+# if defined(TEST_MAP) || defined(TEST_MULTIMAP) || defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS) || defined(TEST_MAP_TRANSPARENT)
 #  include <map>
 # endif
 # if defined(TEST_SET) || defined(TEST_MULTISET)
 #  include <set>
 # endif
+# if defined(TEST_FLAT_MAP) || defined(TEST_FLAT_MULTIMAP)
+#  warning no flat_map in stl
+#  include <map>
+#define flat_map map
+#define flat_multimap multimap
+# endif
+# if defined(TEST_FLAT_SET) || defined(TEST_FLAT_MULTISET)
+#  warning no flat_set in stl
+#  include <set>
+#define flat_set set
+#define flat_multiset multiset
+# endif
+# if defined(TEST_BTREE_MAP) || defined(TEST_BTREE_MULTIMAP)
+#  warning no btree_map in stl
+#  include <map>
+#define btree_map map
+#define btree_multimap multimap
+# endif
+# if defined(TEST_BTREE_SET) || defined(TEST_BTREE_MULTISET)
+#  warning no btree_set in stl
+#  include <set>
+#define btree_set set
+#define btree_multiset multiset
+# endif
 # ifdef TEST_VECTOR
 #  include <vector>
 # endif
+# ifdef TEST_SMALL_VECTOR
+#  warning no small_vector in stl
+#  include <vector>
+# endif
 # ifdef TEST_STACK
 #  include <stack>
 # endif
@@ -74,19 +141,39 @@
 
 #include "container.hpp"
 #include "utils/stateful_comparator.hpp"
-#if defined (TEST_SET) || defined(TEST_MAP) || defined(TEST_MULTISET) || defined(TEST_MULTIMAP)
+#if defined (TEST_SET) || defined(TEST_MAP) || defined(TEST_MULTISET) || defined(TEST_MULTIMAP) || defined (TEST_FLAT_SET) || defined(TEST_FLAT_MAP) || defined(TEST_FLAT_MULTISET) || defined(TEST_FLAT_MULTIMAP) \
+	|| defined (TEST_BTREE_SET) || defined(TEST_BTREE_MAP) || defined(TEST_BTREE_MULTISET) || defined(TEST_BTREE_MULTIMAP) \
+	|| defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS) || defined(TEST_MAP_TRANSPARENT)
 # include "associative.hpp"
 #endif
-#if defined (TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTISET) || defined(TEST_UNORDERED_MULTIMAP)
+#if defined (TEST_SET) || defined(TEST_MAP) || defined(TEST_MAP_ORDER_STATISTICS)
+# include "set_operations.hpp"
+#endif
+#if defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS)
+# include "order_statistics.hpp"
+#endif
+#if defined (TEST_SET) || defined(TEST_MAP) || defined(TEST_MULTISET) || defined(TEST_MULTIMAP) \
+	|| defined(TEST_MAP_ORDER_STATISTICS) || defined(TEST_MULTIMAP_ORDER_STATISTICS)
+# include "visit.hpp"
+#endif
+#if defined (TEST_UNORDERED_SET) || defined(TEST_UNORDERED_MAP) || defined(TEST_UNORDERED_MULTISET) || defined(TEST_UNORDERED_MULTIMAP) \
+	|| defined(TEST_FLAT_HASH_MAP) || defined(TEST_FLAT_HASH_SET) || defined(TEST_UNORDERED_MAP_PRIME) || defined(TEST_UNORDERED_MAP_TRANSPARENT) \
+	|| defined(TEST_UNORDERED_SET_DOUBLE) || defined(TEST_UNORDERED_SET_POINTER)
 # include "unordered_associative.hpp"
 #endif
-#if defined (TEST_VECTOR) || defined(TEST_DEQUE) || defined(TEST_LIST) || defined(TEST_XORLIST) || defined(TEST_STACK) || defined(TEST_QUEUE)
+#if defined(TEST_MAP_TRANSPARENT) || defined(TEST_UNORDERED_MAP_TRANSPARENT)
+# include "transparent.hpp"
+#endif
+#if defined (TEST_VECTOR) || defined(TEST_SMALL_VECTOR) || defined(TEST_DEQUE) || defined(TEST_LIST) || defined(TEST_XORLIST) || defined(TEST_STACK) || defined(TEST_QUEUE)
 # include "list_specific.hpp"
 # include "sequence.hpp"
 #endif
 #if defined (TEST_LIST)
 # include "list_specific.hpp"
 #endif
+#if defined(TEST_VECTOR) && __cplusplus >= 201103L
+# include "rvalue.hpp"
+#endif
 #if defined(TEST_PRIORITY_QUEUE)
 # include "priority_queue.hpp"
 #endif
@@ -123,11 +210,68 @@ void test_unordered_multiset(size_t ntest)
 }
 #endif
 
+#ifdef TEST_FLAT_HASH_MAP
+void test_flat_hash_map(size_t ntest)
+{
+	typedef NAMESPACE::flat_hash_map<std::string, std::string> C;
+	monkey::test_container<C> (container::get_table<C>() + unordered_associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_FLAT_HASH_SET
+void test_flat_hash_set(size_t ntest)
+{
+	typedef NAMESPACE::flat_hash_set<std::string> C;
+	monkey::test_container<C> (container::get_table<C>() + unordered_associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_UNORDERED_MAP_PRIME
+void test_unordered_map_prime(size_t ntest)
+{
+# ifdef TEST_FT
+	typedef NAMESPACE::unordered_map<std::string, std::string, ft::hash<std::string>, ft::equal_to<std::string>,
+			std::allocator<ft::pair<const std::string, std::string> >, ft::hash_table_prime_policy> C;
+# else
+	typedef NAMESPACE::unordered_map<std::string, std::string> C;
+# endif
+	monkey::test_container<C> (container::get_table<C>() + unordered_associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_UNORDERED_MAP_TRANSPARENT
+void test_unordered_map_transparent(size_t ntest)
+{
+# ifdef TEST_FT
+	typedef NAMESPACE::unordered_map<std::string, std::string, key_view_hash, ft::equal_to<> > C;
+# else
+	typedef NAMESPACE::unordered_map<std::string, std::string> C;
+# endif
+	monkey::test_container<C> (container::get_table<C>() + unordered_associative::get_table<C>() + transparent::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_UNORDERED_SET_DOUBLE
+void test_unordered_set_double(size_t ntest)
+{
+	typedef NAMESPACE::unordered_set<double> C;
+	monkey::test_container<C> (container::get_table<C>() + unordered_associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_UNORDERED_SET_POINTER
+void test_unordered_set_pointer(size_t ntest)
+{
+	typedef NAMESPACE::unordered_set<int *> C;
+	monkey::test_container<C> (container::get_table<C>() + unordered_associative::get_table<C>(), ntest);
+}
+#endif
+
 #ifdef TEST_MAP
 void test_map(size_t ntest)
 {
 	typedef NAMESPACE::map<std::string, std::string, stateful_comparator> C;
-	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + set_operations::get_table<C>() + visit::get_table<C>(), ntest);
 }
 #endif
 
@@ -135,7 +279,7 @@ void test_map(size_t ntest)
 void test_set(size_t ntest)
 {
 	typedef NAMESPACE::set<std::string, stateful_comparator> C;
-	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + set_operations::get_table<C>() + visit::get_table<C>(), ntest);
 }
 #endif
 
@@ -143,7 +287,7 @@ void test_set(size_t ntest)
 void test_multimap(size_t ntest)
 {
 	typedef NAMESPACE::multimap<std::string, std::string, stateful_comparator> C;
-	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + visit::get_table<C>() + associative::insert_hint_mapped<C> + associative::insert_range_mapped<C>, ntest);
 }
 #endif
 
@@ -151,6 +295,112 @@ void test_multimap(size_t ntest)
 void test_multiset(size_t ntest)
 {
 	typedef NAMESPACE::multiset<std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + visit::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_MAP_ORDER_STATISTICS
+void test_map_order_statistics(size_t ntest)
+{
+# ifdef TEST_FT
+	typedef NAMESPACE::map<std::string, std::string, stateful_comparator, std::allocator<ft::pair<const std::string, std::string> >, true> C;
+# else
+	typedef NAMESPACE::map<std::string, std::string, stateful_comparator> C;
+# endif
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + set_operations::get_table<C>() + order_statistics::get_table<C>() + visit::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_MULTIMAP_ORDER_STATISTICS
+void test_multimap_order_statistics(size_t ntest)
+{
+# ifdef TEST_FT
+	typedef NAMESPACE::multimap<std::string, std::string, stateful_comparator, std::allocator<ft::pair<const std::string, std::string> >, true> C;
+# else
+	typedef NAMESPACE::multimap<std::string, std::string, stateful_comparator> C;
+# endif
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + order_statistics::get_table<C>() + visit::get_table<C>() + associative::insert_hint_mapped<C> + associative::insert_range_mapped<C>, ntest);
+}
+#endif
+
+#ifdef TEST_MAP_TRANSPARENT
+void test_map_transparent(size_t ntest)
+{
+# ifdef TEST_FT
+	typedef NAMESPACE::map<std::string, std::string, ft::less<> > C;
+# else
+	typedef NAMESPACE::map<std::string, std::string> C;
+# endif
+	monkey::test_container<C> (
+			container::get_table<C>() +
+			associative::get_table<C>() +
+			transparent::get_table<C>() +
+			transparent::lower_bound<C> +
+			transparent::upper_bound<C>
+			, ntest);
+}
+#endif
+
+#ifdef TEST_FLAT_MAP
+void test_flat_map(size_t ntest)
+{
+	typedef NAMESPACE::flat_map<std::string, std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_FLAT_SET
+void test_flat_set(size_t ntest)
+{
+	typedef NAMESPACE::flat_set<std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_FLAT_MULTIMAP
+void test_flat_multimap(size_t ntest)
+{
+	typedef NAMESPACE::flat_multimap<std::string, std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + associative::insert_hint_mapped<C> + associative::insert_range_mapped<C>, ntest);
+}
+#endif
+
+#ifdef TEST_FLAT_MULTISET
+void test_flat_multiset(size_t ntest)
+{
+	typedef NAMESPACE::flat_multiset<std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_BTREE_MAP
+void test_btree_map(size_t ntest)
+{
+	typedef NAMESPACE::btree_map<std::string, std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_BTREE_SET
+void test_btree_set(size_t ntest)
+{
+	typedef NAMESPACE::btree_set<std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
+}
+#endif
+
+#ifdef TEST_BTREE_MULTIMAP
+void test_btree_multimap(size_t ntest)
+{
+	typedef NAMESPACE::btree_multimap<std::string, std::string, stateful_comparator> C;
+	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>() + associative::insert_hint_mapped<C> + associative::insert_range_mapped<C>, ntest);
+}
+#endif
+
+#ifdef TEST_BTREE_MULTISET
+void test_btree_multiset(size_t ntest)
+{
+	typedef NAMESPACE::btree_multiset<std::string, stateful_comparator> C;
 	monkey::test_container<C> (container::get_table<C>() + associative::get_table<C>(), ntest);
 }
 #endif
@@ -159,6 +409,26 @@ void test_multiset(size_t ntest)
 void test_vector(size_t ntest)
 {
 	typedef NAMESPACE::vector<std::string> C;
+	monkey::test_container<C> (
+			container::get_table<C>() +
+			sequence::get_table<C>() +
+# if __cplusplus >= 201103L
+			rvalue::get_table<C>() +
+# endif
+			sequence::at<C> +
+			sequence::operator_at<C>
+			, ntest);
+}
+#endif
+
+#ifdef TEST_SMALL_VECTOR
+void test_small_vector(size_t ntest)
+{
+# ifdef TEST_FT
+	typedef NAMESPACE::small_vector<std::string, 4> C;
+# else
+	typedef NAMESPACE::vector<std::string> C;
+# endif
 	monkey::test_container<C> (
 			container::get_table<C>() +
 			sequence::get_table<C>() +
@@ -276,6 +546,30 @@ int main(int argc, char **argv)
 	test_unordered_multiset(ntest);
 	#endif
 
+	#ifdef TEST_FLAT_HASH_MAP
+	test_flat_hash_map(ntest);
+	#endif
+
+	#ifdef TEST_FLAT_HASH_SET
+	test_flat_hash_set(ntest);
+	#endif
+
+	#ifdef TEST_UNORDERED_MAP_PRIME
+	test_unordered_map_prime(ntest);
+	#endif
+
+	#ifdef TEST_UNORDERED_MAP_TRANSPARENT
+	test_unordered_map_transparent(ntest);
+	#endif
+
+	#ifdef TEST_UNORDERED_SET_DOUBLE
+	test_unordered_set_double(ntest);
+	#endif
+
+	#ifdef TEST_UNORDERED_SET_POINTER
+	test_unordered_set_pointer(ntest);
+	#endif
+
 	#ifdef TEST_MAP
 	test_map(ntest);
 	#endif
@@ -292,10 +586,58 @@ int main(int argc, char **argv)
 	test_multiset(ntest);
 	#endif
 
+	#ifdef TEST_MAP_ORDER_STATISTICS
+	test_map_order_statistics(ntest);
+	#endif
+
+	#ifdef TEST_MULTIMAP_ORDER_STATISTICS
+	test_multimap_order_statistics(ntest);
+	#endif
+
+	#ifdef TEST_MAP_TRANSPARENT
+	test_map_transparent(ntest);
+	#endif
+
+	#ifdef TEST_FLAT_MAP
+	test_flat_map(ntest);
+	#endif
+
+	#ifdef TEST_FLAT_SET
+	test_flat_set(ntest);
+	#endif
+
+	#ifdef TEST_FLAT_MULTIMAP
+	test_flat_multimap(ntest);
+	#endif
+
+	#ifdef TEST_FLAT_MULTISET
+	test_flat_multiset(ntest);
+	#endif
+
+	#ifdef TEST_BTREE_MAP
+	test_btree_map(ntest);
+	#endif
+
+	#ifdef TEST_BTREE_SET
+	test_btree_set(ntest);
+	#endif
+
+	#ifdef TEST_BTREE_MULTIMAP
+	test_btree_multimap(ntest);
+	#endif
+
+	#ifdef TEST_BTREE_MULTISET
+	test_btree_multiset(ntest);
+	#endif
+
 	#ifdef TEST_VECTOR
 	test_vector(ntest);
 	#endif
 
+	#ifdef TEST_SMALL_VECTOR
+	test_small_vector(ntest);
+	#endif
+
 	#ifdef TEST_DEQUE
 	test_deque(ntest);
 	#endif
@@ -0,0 +1,89 @@
+#ifndef MONKEY_TESTER_ORDER_STATISTICS_HPP
+#define MONKEY_TESTER_ORDER_STATISTICS_HPP
+# include "common.hpp"
+# include <iterator>
+
+// nth, rank and count_range of the trees with order statistics,
+// the stl walks the tree with std::advance and std::distance instead
+namespace order_statistics
+{
+	// the key of an element half of the time, a random one otherwise
+	template <class C>
+	typename C::key_type	get_key(C &a)
+	{
+		if (a.empty() || rand() % 2)
+			return typename C::key_type(monkey::get_value());
+		return monkey::get_random_it(a.begin(), monkey::prev(a.end()))->first;
+	}
+
+	template <class C>
+	void	nth(C &a, C &)
+	{
+		FNAME
+		typename C::size_type k = rand() % (a.size() + 2);
+		std::cout << "a.nth(k) with k = " << k << std::endl;
+#ifdef TEST_FT
+		typename C::iterator ret = a.nth(k);
+#else
+		typename C::iterator ret = a.end();
+		if (k < a.size())
+		{
+			ret = a.begin();
+			std::advance(ret, k);
+		}
+#endif
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	template <class C>
+	void	rank(C &a, C &)
+	{
+		FNAME
+		typename C::key_type key = get_key(a);
+		std::cout << "a.rank(key) with key = [" << key << "]" << std::endl;
+#ifdef TEST_FT
+		typename C::size_type ret = a.rank(key);
+#else
+		typename C::size_type ret = std::distance(a.begin(), a.lower_bound(key));
+#endif
+		std::cout << "ret = " << ret << std::endl;
+	}
+
+	template <class C>
+	void	count_range(C &a, C &)
+	{
+		FNAME
+		typename C::key_type lo = get_key(a);
+		typename C::key_type hi = rand() % 4 ? get_key(a) : lo;
+		std::cout << "a.count_range(lo, hi) with lo = [" << lo << "] and hi = [" << hi << "]" << std::endl;
+#ifdef TEST_FT
+		typename C::size_type ret = a.count_range(lo, hi);
+#else
+		typename C::size_type ret = 0;
+		if (a.key_comp()(lo, hi))
+			ret = std::distance(a.lower_bound(lo), a.lower_bound(hi));
+#endif
+		std::cout << "ret = " << ret << std::endl;
+	}
+
+	// count of a multi tree is done with the weights of the nodes
+	template <class C>
+	void	count(C &a, C &)
+	{
+		FNAME
+		typename C::key_type key = get_key(a);
+		std::cout << "a.count(key) with key = [" << key << "]" << std::endl;
+		std::cout << "ret = " << a.count(key) << std::endl;
+	}
+
+	BUILD_TABLE(
+			order_statistics::nth<C>,
+			order_statistics::rank<C>,
+			order_statistics::count_range<C>,
+			order_statistics::count<C>
+	)
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef MONKEY_TESTER_RVALUE_HPP
+#define MONKEY_TESTER_RVALUE_HPP
+# include "common.hpp"
+#ifdef TEST_FT
+# include "utility.hpp"
+#else
+# include <utility>
+#endif
+
+// the rvalue overloads of the sequences, only built in c++11
+namespace rvalue
+{
+	template <class C>
+	void	move_constructor(C &a, C &b)
+	{
+		FNAME
+		std::cout << "a = C(move(b))" << std::endl;
+		C c(NAMESPACE::move(b));
+		a.swap(c);
+	}
+
+	// the moved from b is only valid, it is cleared to print the same thing
+	template <class C>
+	void	move_assign(C &a, C &b)
+	{
+		FNAME
+		std::cout << "a = move(b)" << std::endl;
+		a = NAMESPACE::move(b);
+		b.clear();
+	}
+
+	template <class C>
+	void	push_back_rvalue(C &a, C &)
+	{
+		FNAME
+		typename C::value_type value((monkey::get_value()));
+		std::cout << "a.push_back(move(value)) with value = [" << value << "]" << std::endl;
+		a.push_back(NAMESPACE::move(value));
+	}
+
+	template <class C>
+	void	insert_rvalue(C &a, C &)
+	{
+		FNAME
+		typename C::value_type value((monkey::get_value()));
+		typename C::iterator pos = monkey::get_random_it(a.begin(), a.end());
+		std::cout << "a.insert(pos, move(value)) with pos: ";
+		monkey::print_it(a, pos);
+		std::cout << " and value: [" << value << "]" << std::endl;
+		typename C::iterator ret = a.insert(pos, NAMESPACE::move(value));
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	// built from a count and a character, or from one of the elements of a
+	template <class C>
+	void	emplace(C &a, C &)
+	{
+		FNAME
+		typename C::iterator pos = monkey::get_random_it(a.begin(), a.end());
+		typename C::iterator ret;
+		if (a.empty() || rand() % 2)
+		{
+			size_t count = rand() % BASE_SIZE;
+			char c = 'a' + rand() % 26;
+			std::cout << "a.emplace(pos, count, c) with pos: ";
+			monkey::print_it(a, pos);
+			std::cout << ", count = " << count << " and c = " << c << std::endl;
+			ret = a.emplace(pos, count, c);
+		}
+		else
+		{
+			typename C::iterator value = monkey::get_random_it(a.begin(), monkey::prev(a.end()));
+			std::cout << "a.emplace(pos, *it) with pos: ";
+			monkey::print_it(a, pos);
+			std::cout << " and it: ";
+			monkey::print_it(a, value);
+			std::cout << std::endl;
+			ret = a.emplace(pos, *value);
+		}
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	template <class C>
+	void	emplace_back(C &a, C &)
+	{
+		FNAME
+		size_t count = rand() % BASE_SIZE;
+		char c = 'a' + rand() % 26;
+		std::cout << "a.emplace_back(count, c) with count = " << count << " and c = " << c << std::endl;
+		a.emplace_back(count, c);
+	}
+
+	BUILD_TABLE(
+			move_constructor<C>,
+			move_assign<C>,
+			push_back_rvalue<C>,
+			insert_rvalue<C>,
+			emplace<C>,
+			emplace_back<C>
+	)
+}
+
+#endif
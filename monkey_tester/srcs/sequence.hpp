@@ -50,6 +50,43 @@ namespace sequence
 	}
 
 
+	// the inserted value is one of the elements of a
+	template <class C>
+	void	insert_own_value(C &a, C &)
+	{
+		FNAME
+		if (a.empty())
+			return;
+		typename C::iterator pos = monkey::get_random_it(a.begin(), a.end());
+		typename C::iterator value = monkey::get_random_it(a.begin(), monkey::prev(a.end()));
+		std::cout << "a.insert(pos, *it) with pos: ";
+		monkey::print_it(a, pos);
+		std::cout << " and it: ";
+		monkey::print_it(a, value);
+		std::cout << std::endl;
+		typename C::iterator ret = a.insert(pos, *value);
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	template <class C>
+	void	insert_count_own_value(C &a, C &)
+	{
+		FNAME
+		if (a.empty())
+			return;
+		typename C::iterator pos = monkey::get_random_it(a.begin(), a.end());
+		typename C::iterator value = monkey::get_random_it(a.begin(), monkey::prev(a.end()));
+		typename C::size_type	count = rand() % BASE_SIZE;
+		std::cout << "a.insert(pos, count, *it) with pos = ";
+		monkey::print_it(a, pos);
+		std::cout << ", count = " << count << " and it = ";
+		monkey::print_it(a, value);
+		std::cout << std::endl;
+		a.insert(pos, count, *value);
+	}
+
 	template <class C>
 	void	insert_range(C &a, C &)
 	{
@@ -214,6 +251,8 @@ namespace sequence
 			insert_count<C>,
 			insert_range<C>,
 			insert_value<C>,
+			insert_own_value<C>,
+			insert_count_own_value<C>,
 			count_constructor<C>,
 			range_constructor<C>,
 
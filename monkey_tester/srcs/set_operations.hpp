@@ -0,0 +1,107 @@
+#ifndef MONKEY_TESTER_SET_OPERATIONS_HPP
+#define MONKEY_TESTER_SET_OPERATIONS_HPP
+# include "common.hpp"
+# include <algorithm>
+# include <iterator>
+
+// set_union, set_intersection and set_difference of the unique trees,
+// the stl does them with the algorithms of <algorithm> in a new container
+namespace set_operations
+{
+	template <class C>
+	void	do_union(C &a, const C &other)
+	{
+#ifdef TEST_FT
+		a.set_union(other);
+#else
+		C c(a.key_comp());
+		std::set_union(a.begin(), a.end(), other.begin(), other.end(), std::inserter(c, c.end()), a.value_comp());
+		a.swap(c);
+#endif
+	}
+
+	template <class C>
+	void	do_intersection(C &a, const C &other)
+	{
+#ifdef TEST_FT
+		a.set_intersection(other);
+#else
+		C c(a.key_comp());
+		std::set_intersection(a.begin(), a.end(), other.begin(), other.end(), std::inserter(c, c.end()), a.value_comp());
+		a.swap(c);
+#endif
+	}
+
+	template <class C>
+	void	do_difference(C &a, const C &other)
+	{
+#ifdef TEST_FT
+		a.set_difference(other);
+#else
+		C c(a.key_comp());
+		std::set_difference(a.begin(), a.end(), other.begin(), other.end(), std::inserter(c, c.end()), a.value_comp());
+		a.swap(c);
+#endif
+	}
+
+	// the second operand, sorted like a: a itself, a few keys (the one by one path of the trees) or the content of b
+	template <class C>
+	const C	&get_operand(C &a, C &b, C &tmp)
+	{
+		switch (rand() % 4)
+		{
+			case 0:
+				std::cout << "other = a" << std::endl;
+				return a;
+			case 1:
+				if (!a.empty())
+					tmp.insert(*monkey::get_random_it(a.begin(), monkey::prev(a.end())));
+				tmp.insert(typename C::value_type(monkey::get_value()));
+				std::cout << "other = a few keys" << std::endl;
+				break;
+			default:
+				tmp.insert(b.begin(), b.end());
+				std::cout << "other = b" << std::endl;
+		}
+		monkey::print(tmp);
+		return tmp;
+	}
+
+	template <class C>
+	void	set_union(C &a, C &b)
+	{
+		FNAME
+		C tmp(a.key_comp());
+		const C &other = get_operand(a, b, tmp);
+		std::cout << "a.set_union(other)" << std::endl;
+		do_union(a, other);
+	}
+
+	template <class C>
+	void	set_intersection(C &a, C &b)
+	{
+		FNAME
+		C tmp(a.key_comp());
+		const C &other = get_operand(a, b, tmp);
+		std::cout << "a.set_intersection(other)" << std::endl;
+		do_intersection(a, other);
+	}
+
+	template <class C>
+	void	set_difference(C &a, C &b)
+	{
+		FNAME
+		C tmp(a.key_comp());
+		const C &other = get_operand(a, b, tmp);
+		std::cout << "a.set_difference(other)" << std::endl;
+		do_difference(a, other);
+	}
+
+	BUILD_TABLE(
+			set_operations::set_union<C>,
+			set_operations::set_intersection<C>,
+			set_operations::set_difference<C>
+	)
+}
+
+#endif
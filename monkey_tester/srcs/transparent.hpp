@@ -0,0 +1,82 @@
+#ifndef MONKEY_TESTER_TRANSPARENT_HPP
+#define MONKEY_TESTER_TRANSPARENT_HPP
+# include "common.hpp"
+# include "utils/key_view.hpp"
+
+// lookups with a key_view on the containers with transparent functors,
+// the stl ones are looked up with the std::string it views
+# ifdef TEST_FT
+#  define LOOKUP_KEY(key) key_view(key)
+# else
+#  define LOOKUP_KEY(key) key
+# endif
+
+namespace transparent
+{
+	template <class C>
+	void	find(C &a, C &)
+	{
+		FNAME
+		std::string key((monkey::get_value()));
+		std::cout << "a.find(key) with key = [" << LOOKUP_KEY(key) << "]" << std::endl;
+		typename C::iterator ret = a.find(LOOKUP_KEY(key));
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	template <class C>
+	void	count(C &a, C &)
+	{
+		FNAME
+		std::string key((monkey::get_value()));
+		std::cout << "a.count(key) with key = [" << LOOKUP_KEY(key) << "]" << std::endl;
+		std::cout << "ret = " << a.count(LOOKUP_KEY(key)) << std::endl;
+	}
+
+	template <class C>
+	void	equal_range(C &a, C &)
+	{
+		FNAME
+		std::string key((monkey::get_value()));
+		std::cout << "a.equal_range(key) with key = [" << LOOKUP_KEY(key) << "]" << std::endl;
+		NAMESPACE::pair<typename C::iterator, typename C::iterator> ret = a.equal_range(LOOKUP_KEY(key));
+		// the elements of the range, its end is in no particular order in the unordered containers
+		std::cout << "ret = ";
+		monkey::print_range(ret.first, ret.second);
+		std::cout << std::endl;
+	}
+
+	// only for the trees
+	template <class C>
+	void	lower_bound(C &a, C &)
+	{
+		FNAME
+		std::string key((monkey::get_value()));
+		std::cout << "a.lower_bound(key) with key = [" << LOOKUP_KEY(key) << "]" << std::endl;
+		typename C::iterator ret = a.lower_bound(LOOKUP_KEY(key));
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	template <class C>
+	void	upper_bound(C &a, C &)
+	{
+		FNAME
+		std::string key((monkey::get_value()));
+		std::cout << "a.upper_bound(key) with key = [" << LOOKUP_KEY(key) << "]" << std::endl;
+		typename C::iterator ret = a.upper_bound(LOOKUP_KEY(key));
+		std::cout << "ret = ";
+		monkey::print_it(a, ret);
+		std::cout << std::endl;
+	}
+
+	BUILD_TABLE(
+			transparent::find<C>,
+			transparent::count<C>,
+			transparent::equal_range<C>
+	)
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef MONKEY_TESTER_KEY_VIEW_HPP
+#define MONKEY_TESTER_KEY_VIEW_HPP
+# include <string>
+# include <iostream>
+
+// the characters of a string without a copy, it does not convert to std::string
+// so a lookup with it compiles only through the transparent overloads
+class key_view
+{
+private:
+	const char	*data;
+	size_t		size;
+public:
+	explicit key_view(const std::string &s) : data(s.data()), size(s.size()) {}
+	const char	*begin() const {return this->data;}
+	size_t		length() const {return this->size;}
+	int			compare(const std::string &s) const {return -s.compare(0, s.size(), this->data, this->size);}
+	friend bool operator<(const key_view &l, const std::string &r) {return l.compare(r) < 0;}
+	friend bool operator<(const std::string &l, const key_view &r) {return r.compare(l) > 0;}
+	friend bool operator==(const key_view &l, const std::string &r) {return l.compare(r) == 0;}
+	friend bool operator==(const std::string &l, const key_view &r) {return r.compare(l) == 0;}
+	friend std::ostream &operator<<(std::ostream &s, const key_view &k) {return s.write(k.data, k.size);}
+};
+
+# ifdef TEST_FT
+#  include "functional.hpp"
+// hash the characters like ft::hash<std::string>, so the key and its view land in the same bucket
+struct key_view_hash
+{
+	typedef void	is_transparent;
+	size_t	operator()(const std::string &s) const {return ft::hash<std::string>()(s);}
+	size_t	operator()(const key_view &k) const {return ft::hash_bytes(k.begin(), k.length());}
+};
+# endif
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef MONKEY_TESTER_VISIT_HPP
+#define MONKEY_TESTER_VISIT_HPP
+# include "common.hpp"
+# include <algorithm>
+
+// for_each and visit_range of the trees, the stl iterates [begin, end) and [lower_bound(lo), lower_bound(hi)) instead
+namespace visit
+{
+	// print the elements it is called on and count them
+	template <class T>
+	struct printer
+	{
+		int	count;
+		printer() : count(0) {}
+		void	operator()(const T &value)
+		{
+			std::cout << "-> [" << value << "]" << std::endl;
+			this->count++;
+		}
+	};
+
+	template <class K>
+	const K	&key_of(const K &key) {return key;}
+
+	template <class K, class V>
+	const K	&key_of(const NAMESPACE::pair<const K, V> &value) {return value.first;}
+
+	// the key of an element half of the time, a random one otherwise
+	template <class C>
+	typename C::key_type	get_key(C &a)
+	{
+		if (a.empty() || rand() % 2)
+			return typename C::key_type(monkey::get_value());
+		return key_of(*monkey::get_random_it(a.begin(), monkey::prev(a.end())));
+	}
+
+	template <class C, class Container>
+	printer<typename C::value_type>	do_for_each(Container &a)
+	{
+#ifdef TEST_FT
+		return a.for_each(printer<typename C::value_type>());
+#else
+		return std::for_each(a.begin(), a.end(), printer<typename C::value_type>());
+#endif
+	}
+
+	template <class C, class Container>
+	printer<typename C::value_type>	do_visit_range(Container &a, const typename C::key_type &lo, const typename C::key_type &hi)
+	{
+#ifdef TEST_FT
+		return a.visit_range(lo, hi, printer<typename C::value_type>());
+#else
+		// lower_bound(hi) is before lower_bound(lo) in an inverted range
+		if (!a.key_comp()(lo, hi))
+			return printer<typename C::value_type>();
+		return std::for_each(a.lower_bound(lo), a.lower_bound(hi), printer<typename C::value_type>());
+#endif
+	}
+
+	template <class C>
+	void	for_each(C &a, C &)
+	{
+		FNAME
+		printer<typename C::value_type> ret;
+		if (rand() % 2)
+		{
+			std::cout << "a.for_each(fn)" << std::endl;
+			ret = do_for_each<C>(a);
+		}
+		else
+		{
+			std::cout << "a.for_each(fn) on a const a" << std::endl;
+			ret = do_for_each<C>(static_cast<const C &>(a));
+		}
+		std::cout << "fn called " << ret.count << " times" << std::endl;
+	}
+
+	template <class C>
+	void	visit_range(C &a, C &)
+	{
+		FNAME
+		typename C::key_type lo = get_key(a);
+		typename C::key_type hi = rand() % 4 ? get_key(a) : lo;
+		printer<typename C::value_type> ret;
+		if (rand() % 2)
+		{
+			std::cout << "a.visit_range(lo, hi, fn) with lo = [" << lo << "] and hi = [" << hi << "]" << std::endl;
+			ret = do_visit_range<C>(a, lo, hi);
+		}
+		else
+		{
+			std::cout << "a.visit_range(lo, hi, fn) on a const a with lo = [" << lo << "] and hi = [" << hi << "]" << std::endl;
+			ret = do_visit_range<C>(static_cast<const C &>(a), lo, hi);
+		}
+		std::cout << "fn called " << ret.count << " times" << std::endl;
+	}
+
+	BUILD_TABLE(
+			visit::for_each<C>,
+			visit::visit_range<C>,
+			visit::visit_range<C>
+	)
+}
+
+#endif